@@ -0,0 +1,121 @@
+// This example compares `tiny::frequency_sketch` with a sketch of byte counters.
+// Build it in release mode, the numbers are meaningless otherwise.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <foonathan/tiny/frequency_sketch.hpp> // for `tiny::frequency_sketch`
+
+namespace tiny = foonathan::tiny;
+
+// The straightforward implementation: four rows of byte counters,
+// so it needs twice the memory for the same number of counters,
+// and every operation touches four different cache lines.
+template <std::size_t Size>
+class byte_sketch
+{
+public:
+    byte_sketch() : counters_{}, additions_(0u) {}
+
+    void increment(std::uint64_t hash) noexcept
+    {
+        auto mixed = tiny::detail::mix_hash(hash);
+        auto min   = min_counter(mixed);
+        if (min == 15u)
+            return;
+
+        for (auto row = 0u; row != 4u; ++row)
+        {
+            auto& counter = counters_[row][index_of(mixed, row)];
+            if (counter == min)
+                ++counter;
+        }
+
+        if (++additions_ == 10u * Size)
+            reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& row : counters_)
+            for (auto& counter : row)
+                counter = static_cast<unsigned char>(counter / 2u);
+        additions_ /= 2u;
+    }
+
+    std::size_t estimate(std::uint64_t hash) const noexcept
+    {
+        return min_counter(tiny::detail::mix_hash(hash));
+    }
+
+private:
+    static std::size_t index_of(std::uint64_t mixed, unsigned row) noexcept
+    {
+        // the same number of counters as the frequency sketch
+        return std::size_t(mixed >> (16u * row)) & (4u * Size - 1u);
+    }
+
+    unsigned min_counter(std::uint64_t mixed) const noexcept
+    {
+        auto result = 15u;
+        for (auto row = 0u; row != 4u; ++row)
+        {
+            unsigned counter = counters_[row][index_of(mixed, row)];
+            if (counter < result)
+                result = counter;
+        }
+        return result;
+    }
+
+    unsigned char counters_[4][4u * Size];
+    std::size_t   additions_;
+};
+
+// Skewed keys: small keys are a lot more frequent than big ones.
+std::vector<std::uint64_t> make_keys(std::size_t count)
+{
+    std::vector<std::uint64_t> result;
+    result.reserve(count);
+
+    std::uint64_t state = 42u;
+    for (auto i = std::size_t(0); i != count; ++i)
+    {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        auto bits = 1u + (state >> 59); // [1, 32]
+        result.push_back(tiny::detail::mix_hash(state) >> (64u - bits));
+    }
+    return result;
+}
+
+template <class Sketch>
+void run(const char* name, const std::vector<std::uint64_t>& keys)
+{
+    std::unique_ptr<Sketch> sketch(new Sketch);
+
+    auto        begin = std::chrono::steady_clock::now();
+    std::size_t sum   = 0;
+    for (auto key : keys)
+    {
+        // like a cache admission: compare the frequency, then record the access
+        sum += sketch->estimate(key);
+        sketch->increment(key);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    auto ns = std::chrono::duration<double, std::nano>(end - begin).count();
+    std::cout << name << ": " << sizeof(Sketch) / 1024 << " KiB, "
+              << ns / double(keys.size()) << " ns per access (checksum " << sum << ")\n";
+}
+
+int main()
+{
+    constexpr auto size = std::size_t(1) << 16;
+    auto           keys = make_keys(std::size_t(1) << 24);
+
+    // both have 2^20 counters
+    run<tiny::frequency_sketch<size>>("tiny::frequency_sketch", keys);
+    run<byte_sketch<size>>("byte_sketch", keys);
+}
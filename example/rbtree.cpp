@@ -0,0 +1,164 @@
+// This example compares `tiny::rbtree` with `std::set`.
+// Build it in release mode, the numbers are meaningless otherwise.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include <foonathan/tiny/rbtree.hpp> // for `tiny::rbtree`
+
+namespace tiny = foonathan::tiny;
+
+// An element of the intrusive tree: the color is stored in the parent pointer of the hook,
+// so it is just three pointers plus the key.
+struct element : tiny::rbtree_hook
+{
+    std::uint64_t key;
+
+    explicit element(std::uint64_t key) : key(key) {}
+};
+
+// allows lookup by key
+struct key_compare
+{
+    bool operator()(const element& lhs, const element& rhs) const noexcept
+    {
+        return lhs.key < rhs.key;
+    }
+    bool operator()(const element& lhs, std::uint64_t rhs) const noexcept
+    {
+        return lhs.key < rhs;
+    }
+    bool operator()(std::uint64_t lhs, const element& rhs) const noexcept
+    {
+        return lhs < rhs.key;
+    }
+};
+
+// Counts the bytes `std::set` allocates for its nodes.
+std::size_t allocated_bytes = 0;
+
+template <typename T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    counting_allocator() = default;
+    template <typename U>
+    counting_allocator(const counting_allocator<U>&) noexcept
+    {}
+
+    T* allocate(std::size_t n)
+    {
+        allocated_bytes += n * sizeof(T);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* ptr, std::size_t n) noexcept
+    {
+        std::allocator<T>().deallocate(ptr, n);
+    }
+
+    friend bool operator==(counting_allocator, counting_allocator) noexcept
+    {
+        return true;
+    }
+    friend bool operator!=(counting_allocator, counting_allocator) noexcept
+    {
+        return false;
+    }
+};
+
+std::vector<std::uint64_t> make_keys(std::size_t count)
+{
+    std::vector<std::uint64_t> result;
+    result.reserve(count);
+
+    std::uint64_t state = 42u;
+    for (auto i = std::size_t(0); i != count; ++i)
+    {
+        state = state * 6364136223846793005u + 1442695040888963407u;
+        result.push_back(state);
+    }
+    return result;
+}
+
+template <typename Func>
+double ns_per_op(std::size_t count, Func f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / double(count);
+}
+
+void report(const char* name, double bytes, double insert, double lookup, double erase,
+            std::size_t checksum)
+{
+    std::cout << name << ": " << bytes << " bytes per node, " << insert << " ns per insert, "
+              << lookup << " ns per lookup, " << erase << " ns per erase (checksum " << checksum
+              << ")\n";
+}
+
+void run_rbtree(const std::vector<std::uint64_t>& keys)
+{
+    // the tree doesn't allocate, the elements are stored in a vector
+    std::vector<element> elements(keys.begin(), keys.end());
+
+    tiny::rbtree<element, key_compare> tree;
+
+    auto insert = ns_per_op(keys.size(), [&] {
+        for (auto& e : elements)
+            tree.insert_unique(e);
+    });
+
+    std::size_t checksum = 0;
+    auto        lookup = ns_per_op(keys.size(), [&] {
+        for (auto key : keys)
+            checksum += tree.find(key)->key & 1u;
+    });
+
+    auto erase = ns_per_op(keys.size(), [&] {
+        for (auto& e : elements)
+            tree.erase(e);
+    });
+
+    report("tiny::rbtree", double(sizeof(element)), insert, lookup, erase, checksum);
+}
+
+void run_set(const std::vector<std::uint64_t>& keys)
+{
+    std::set<std::uint64_t, std::less<std::uint64_t>, counting_allocator<std::uint64_t>> set;
+
+    allocated_bytes = 0;
+    auto insert = ns_per_op(keys.size(), [&] {
+        for (auto key : keys)
+            set.insert(key);
+    });
+    auto bytes = double(allocated_bytes) / double(set.size());
+
+    std::size_t checksum = 0;
+    auto        lookup = ns_per_op(keys.size(), [&] {
+        for (auto key : keys)
+            checksum += *set.find(key) & 1u;
+    });
+
+    auto erase = ns_per_op(keys.size(), [&] {
+        for (auto key : keys)
+            set.erase(key);
+    });
+
+    report("std::set", bytes, insert, lookup, erase, checksum);
+}
+
+int main()
+{
+    // the keys are distinct, as the LCG has full period, and in random order
+    auto keys = make_keys(std::size_t(1) << 20);
+
+    run_rbtree(keys);
+    run_set(keys);
+}
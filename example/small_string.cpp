@@ -0,0 +1,89 @@
+// This example compares `tiny::small_string` with `std::string`.
+// Build it in release mode, the numbers are meaningless otherwise.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <foonathan/tiny/small_string.hpp> // for `tiny::small_string`
+
+namespace tiny = foonathan::tiny;
+
+// Random lowercase strings that all have the same length.
+std::vector<std::string> make_sources(std::size_t count, std::size_t length)
+{
+    std::vector<std::string> result;
+    result.reserve(count);
+
+    std::uint64_t state = 42u;
+    for (auto i = std::size_t(0); i != count; ++i)
+    {
+        std::string str;
+        for (auto j = std::size_t(0); j != length; ++j)
+        {
+            state = state * 6364136223846793005u + 1442695040888963407u;
+            str.push_back(char('a' + (state >> 59)));
+        }
+        result.push_back(str);
+    }
+    return result;
+}
+
+template <typename Func>
+double ns_per_op(std::size_t count, Func f)
+{
+    auto begin = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - begin).count() / double(count);
+}
+
+template <class String>
+void run(const char* name, const std::vector<std::string>& sources, bool print = true)
+{
+    auto count = sources.size();
+
+    std::vector<String> strings;
+    strings.reserve(count);
+    auto construct = ns_per_op(count, [&] {
+        for (auto& source : sources)
+            strings.emplace_back(source.data(), source.size());
+    });
+
+    std::vector<String> copies;
+    copies.reserve(count);
+    auto copy = ns_per_op(count, [&] {
+        for (auto& str : strings)
+            copies.push_back(str);
+    });
+
+    // compares equal strings, which have to look at every character, and different ones
+    std::size_t checksum = 0;
+    auto        compare  = ns_per_op(count, [&] {
+        for (auto i = std::size_t(0); i != count; ++i)
+            checksum += (strings[i] == copies[i]) + (strings[i] < copies[count - i - 1u]);
+    });
+
+    if (!print)
+        return;
+    std::cout << name << " (" << sources.front().size() << " characters): " << construct
+              << " ns per construction, " << copy << " ns per copy, " << compare
+              << " ns per comparison (checksum " << checksum << ")\n";
+}
+
+int main()
+{
+    auto count = std::size_t(1) << 20;
+    // the first run pays for the page faults of fresh heap memory
+    run<std::string>("warmup", make_sources(count, 64u), false);
+
+    // 23 characters are still stored inline, 24 are not
+    for (auto length : {std::size_t(15), std::size_t(23), std::size_t(24), std::size_t(64)})
+    {
+        auto sources = make_sources(count, length);
+        run<tiny::small_string>("tiny::small_string", sources);
+        run<std::string>("std::string", sources);
+    }
+}
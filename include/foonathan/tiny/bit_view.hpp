@@ -210,6 +210,17 @@ namespace tiny
     /// `bit_view<int32_t, 0, last_bit>` is equivalent to `bit_view<int32_t, 0, 32>`.
     constexpr std::size_t last_bit = std::size_t(-1);
 
+    /// \exclude
+    namespace bit_view_detail
+    {
+        // index of a subview bit in the parent, last_bit refers to the end of the parent view
+        constexpr std::size_t subview_index(std::size_t begin, std::size_t end,
+                                            std::size_t sub) noexcept
+        {
+            return sub == last_bit ? end : begin + sub;
+        }
+    } // namespace bit_view_detail
+
     /// A view to the given range `[Begin, End)` of bits in an integer type.
     template <typename Integer, std::size_t Begin, std::size_t End>
     class bit_view
@@ -263,11 +274,15 @@ namespace tiny
         {}
 
         /// \returns A view to a subrange.
-        /// \notes The indices are in the range `[0, size())`, where `0` is the `Begin` bit.
+        /// \notes The indices are in the range `[0, size())`, where `0` is the `Begin` bit,
+        /// `last_bit` refers to the end of this view.
         template <std::size_t SubBegin, std::size_t SubEnd>
-        bit_view<Integer, Begin + SubBegin, Begin + SubEnd> subview() const noexcept
+        bit_view<Integer, bit_view_detail::subview_index(Begin, End, SubBegin),
+                 bit_view_detail::subview_index(Begin, End, SubEnd)>
+            subview() const noexcept
         {
-            using result = bit_view<Integer, Begin + SubBegin, Begin + SubEnd>;
+            using result = bit_view<Integer, bit_view_detail::subview_index(Begin, End, SubBegin),
+                                    bit_view_detail::subview_index(Begin, End, SubEnd)>;
             static_assert(begin() <= result::begin() && result::end() <= end(),
                           "view not a subview");
             return result(*reinterpret_cast<Integer*>(pointer_));
@@ -384,11 +399,15 @@ namespace tiny
         {}
 
         /// \returns A view to a subrange.
-        /// \notes The indices are in the range `[0, size())`, where `0` is the `Begin` bit.
+        /// \notes The indices are in the range `[0, size())`, where `0` is the `Begin` bit,
+        /// `last_bit` refers to the end of this view.
         template <std::size_t SubBegin, std::size_t SubEnd>
-        bit_view<Integer[N], Begin + SubBegin, Begin + SubEnd> subview() const noexcept
+        bit_view<Integer[N], bit_view_detail::subview_index(Begin, End, SubBegin),
+                 bit_view_detail::subview_index(Begin, End, SubEnd)>
+            subview() const noexcept
         {
-            using result = bit_view<Integer[N], Begin + SubBegin, Begin + SubEnd>;
+            using result = bit_view<Integer[N], bit_view_detail::subview_index(Begin, End, SubBegin),
+                                    bit_view_detail::subview_index(Begin, End, SubEnd)>;
             static_assert(begin() <= result::begin() && result::end() <= end(),
                           "view not a subview");
             return result(0, pointer_);
@@ -0,0 +1,453 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_COMPACT_VECTOR_HPP_INCLUDED
+#define FOONATHAN_TINY_COMPACT_VECTOR_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include <foonathan/tiny/detail/ilog2.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace vector_detail
+    {
+        constexpr std::size_t size_bits     = 26u;
+        constexpr std::size_t capacity_bits = 5u;
+
+        // the header with the remaining bytes of two pointers is inline storage
+        constexpr std::size_t inline_bytes = 2u * sizeof(void*) - sizeof(std::uint32_t);
+
+        inline void* allocate(std::size_t bytes)
+        {
+            auto result = std::malloc(bytes);
+            if (!result)
+                throw std::bad_alloc();
+            return result;
+        }
+
+        // frees the memory unless released
+        struct memory_guard
+        {
+            void* memory;
+
+            ~memory_guard() noexcept
+            {
+                std::free(memory);
+            }
+        };
+
+        // moves the objects to uninitialized memory and destroys the originals
+        template <typename T>
+        void relocate(T* from, std::size_t count, T* to, std::true_type) noexcept
+        {
+            if (count > 0u)
+                std::memcpy(static_cast<void*>(to), static_cast<const void*>(from),
+                            count * sizeof(T));
+        }
+        template <typename T>
+        void relocate(T* from, std::size_t count, T* to, std::false_type) noexcept
+        {
+            for (auto i = std::size_t(0); i != count; ++i)
+            {
+                ::new (static_cast<void*>(to + i)) T(std::move(from[i]));
+                from[i].~T();
+            }
+        }
+    } // namespace vector_detail
+
+    /// A vector that is only two pointers big.
+    ///
+    /// The size, the logarithm of the capacity and a flag whether or not the elements are on the
+    /// heap are packed into a 32 bit [tiny::tiny_storage]().
+    /// The remaining bytes next to it store the heap pointer,
+    /// or, if they fit, the elements themselves, e.g. three `std::uint32_t` on a 64 bit platform.
+    ///
+    /// The heap capacity is always a power of two.
+    /// If `T` is [tiny::is_trivially_relocatable](), growing uses `std::realloc()`
+    /// and moving elements uses `std::memcpy()`.
+    /// \requires `T` must be trivially relocatable or nothrow move constructible,
+    /// and must not be over-aligned.
+    template <typename T>
+    class compact_vector
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "over-aligned types not supported");
+        static_assert(is_trivially_relocatable<T>::value
+                          || std::is_nothrow_move_constructible<T>::value,
+                      "T must be trivially relocatable or nothrow move constructible");
+
+        using relocatable = std::integral_constant<bool, is_trivially_relocatable<T>::value>;
+
+    public:
+        using value_type     = T;
+        using iterator       = T*;
+        using const_iterator = const T*;
+
+        //=== constructors ===//
+        /// \effects Creates an empty vector using the inline storage.
+        compact_vector() noexcept : buffer_{}, header_(false, 0u, 0u) {}
+
+        /// \effects Creates a vector containing copies of the elements of the other one.
+        compact_vector(const compact_vector& other) : compact_vector()
+        {
+            append(other);
+        }
+
+        /// \effects Creates a vector containing the elements of the other one,
+        /// leaving it empty.
+        compact_vector(compact_vector&& other) noexcept : compact_vector()
+        {
+            steal(other);
+        }
+
+        /// \effects Destroys the elements and frees the memory.
+        ~compact_vector() noexcept
+        {
+            clear();
+            if (is_heap())
+                std::free(heap_pointer());
+        }
+
+        /// \effects Replaces the elements by copies of the elements of the other vector.
+        compact_vector& operator=(const compact_vector& other)
+        {
+            if (this != &other)
+            {
+                clear();
+                append(other);
+            }
+            return *this;
+        }
+
+        /// \effects Replaces the elements by the elements of the other vector,
+        /// leaving it empty.
+        compact_vector& operator=(compact_vector&& other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                if (is_heap())
+                    std::free(heap_pointer());
+                header_ = decltype(header_)(false, 0u, 0u);
+                steal(other);
+            }
+            return *this;
+        }
+
+        //=== modifiers ===//
+        /// \effects Appends a new element constructed from the arguments.
+        /// \returns A reference to the new element.
+        /// \requires `size() < max_size()`.
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            auto cur_size = size();
+            if (cur_size == capacity())
+                // the arguments might refer to an existing element
+                grow_emplace(relocatable{}, std::forward<Args>(args)...);
+            else
+                ::new (static_cast<void*>(data() + cur_size)) T(std::forward<Args>(args)...);
+
+            set_size(cur_size + 1u);
+            return back();
+        }
+
+        /// \effects Appends a copy of the element.
+        void push_back(const T& value)
+        {
+            emplace_back(value);
+        }
+        /// \effects Appends the element by moving it.
+        void push_back(T&& value)
+        {
+            emplace_back(std::move(value));
+        }
+
+        /// \effects Destroys the last element.
+        /// \requires `!empty()`.
+        void pop_back() noexcept
+        {
+            DEBUG_ASSERT(!empty(), detail::precondition_handler{}, "vector is empty");
+            set_size(size() - 1u);
+            data()[size()].~T();
+        }
+
+        /// \effects Destroys all elements, but keeps the memory.
+        void clear() noexcept
+        {
+            auto ptr = data();
+            for (auto i = std::size_t(0); i != size(); ++i)
+                ptr[i].~T();
+            set_size(0u);
+        }
+
+        /// \effects Destroys the elements after `new_size`,
+        /// or appends value initialized elements until it has `new_size` elements.
+        /// \requires `new_size <= max_size()`.
+        void resize(std::size_t new_size)
+        {
+            while (size() > new_size)
+                pop_back();
+            reserve(new_size);
+            while (size() < new_size)
+                emplace_back();
+        }
+
+        /// \effects Ensures that the capacity is at least `new_capacity`,
+        /// so appending up to that many elements does not allocate.
+        /// \requires `new_capacity <= max_size()`.
+        void reserve(std::size_t new_capacity)
+        {
+            if (new_capacity > capacity())
+                reallocate(detail::ilog2_ceil(new_capacity), relocatable{});
+        }
+
+        //=== accessors ===//
+        /// \returns A pointer to the elements.
+        T* data() noexcept
+        {
+            return is_heap() ? heap_pointer() : reinterpret_cast<T*>(buffer_);
+        }
+        const T* data() const noexcept
+        {
+            return const_cast<compact_vector&>(*this).data();
+        }
+
+        /// \returns The element at the given position.
+        /// \requires `i < size()`.
+        T& operator[](std::size_t i) noexcept
+        {
+            DEBUG_ASSERT(i < size(), detail::precondition_handler{}, "index out of range");
+            return data()[i];
+        }
+        const T& operator[](std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < size(), detail::precondition_handler{}, "index out of range");
+            return data()[i];
+        }
+
+        /// \returns The first element.
+        /// \requires `!empty()`.
+        T& front() noexcept
+        {
+            return (*this)[0];
+        }
+        const T& front() const noexcept
+        {
+            return (*this)[0];
+        }
+
+        /// \returns The last element.
+        /// \requires `!empty()`.
+        T& back() noexcept
+        {
+            return (*this)[size() - 1u];
+        }
+        const T& back() const noexcept
+        {
+            return (*this)[size() - 1u];
+        }
+
+        iterator begin() noexcept
+        {
+            return data();
+        }
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        iterator end() noexcept
+        {
+            return data() + size();
+        }
+        const_iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        //=== capacity ===//
+        /// \returns Whether or not the vector is empty.
+        bool empty() const noexcept
+        {
+            return size() == 0u;
+        }
+
+        /// \returns The number of elements.
+        std::size_t size() const noexcept
+        {
+            return header_.template at<2>();
+        }
+
+        /// \returns The number of elements it can store without allocating memory.
+        std::size_t capacity() const noexcept
+        {
+            return is_heap() ? std::size_t(1) << header_.template at<1>() : inline_capacity();
+        }
+
+        /// \returns The number of elements that can be stored inline, without any allocation.
+        static constexpr std::size_t inline_capacity() noexcept
+        {
+            return vector_detail::inline_bytes / sizeof(T);
+        }
+
+        /// \returns The maximal number of elements.
+        static constexpr std::size_t max_size() noexcept
+        {
+            return (std::size_t(1) << vector_detail::size_bits) - 1u;
+        }
+
+        /// \returns Whether or not the elements are stored on the heap.
+        bool is_heap() const noexcept
+        {
+            return header_.template at<0>();
+        }
+
+    private:
+        T* heap_pointer() const noexcept
+        {
+            T* result;
+            std::memcpy(&result, buffer_, sizeof(result));
+            return result;
+        }
+
+        void set_heap(T* ptr, std::size_t log2_capacity) noexcept
+        {
+            std::memcpy(buffer_, &ptr, sizeof(ptr));
+            header_.template at<0>() = true;
+            header_.template at<1>() = unsigned(log2_capacity);
+        }
+
+        void set_size(std::size_t size) noexcept
+        {
+            header_.template at<2>() = std::uint32_t(size);
+        }
+
+        std::size_t grown_log2_capacity() const noexcept
+        {
+            DEBUG_ASSERT(size() < max_size(), detail::precondition_handler{}, "vector is full");
+            // at least four elements, then double the capacity
+            auto cur = capacity();
+            return detail::ilog2_ceil(cur < 2u ? 4u : 2u * cur);
+        }
+
+        // moves the elements into a new heap allocation of the given capacity
+        void reallocate(std::size_t log2_capacity, std::false_type)
+        {
+            DEBUG_ASSERT((std::size_t(1) << log2_capacity) <= max_size() + 1u,
+                         detail::precondition_handler{}, "capacity too big");
+            auto memory = static_cast<T*>(
+                vector_detail::allocate((std::size_t(1) << log2_capacity) * sizeof(T)));
+            vector_detail::relocate(data(), size(), memory, relocatable{});
+            if (is_heap())
+                std::free(heap_pointer());
+            set_heap(memory, log2_capacity);
+        }
+        void reallocate(std::size_t log2_capacity, std::true_type)
+        {
+            if (!is_heap())
+                return reallocate(log2_capacity, std::false_type{});
+
+            DEBUG_ASSERT((std::size_t(1) << log2_capacity) <= max_size() + 1u,
+                         detail::precondition_handler{}, "capacity too big");
+            auto memory
+                = std::realloc(heap_pointer(), (std::size_t(1) << log2_capacity) * sizeof(T));
+            if (!memory)
+                throw std::bad_alloc();
+            set_heap(static_cast<T*>(memory), log2_capacity);
+        }
+
+        template <typename... Args>
+        void grow_emplace(std::true_type, Args&&... args)
+        {
+            // construct it in temporary storage, so it can be relocated after growing
+            alignas(T) unsigned char storage[sizeof(T)];
+            auto value = ::new (static_cast<void*>(storage)) T(std::forward<Args>(args)...);
+
+            auto log2_capacity = grown_log2_capacity();
+            auto bytes         = (std::size_t(1) << log2_capacity) * sizeof(T);
+
+            auto memory = is_heap() ? std::realloc(heap_pointer(), bytes) : std::malloc(bytes);
+            if (!memory)
+            {
+                value->~T();
+                throw std::bad_alloc();
+            }
+            else if (!is_heap())
+                vector_detail::relocate(data(), size(), static_cast<T*>(memory), relocatable{});
+
+            vector_detail::relocate(value, 1u, static_cast<T*>(memory) + size(), relocatable{});
+            set_heap(static_cast<T*>(memory), log2_capacity);
+        }
+        template <typename... Args>
+        void grow_emplace(std::false_type, Args&&... args)
+        {
+            auto                        log2_capacity = grown_log2_capacity();
+            vector_detail::memory_guard guard{
+                vector_detail::allocate((std::size_t(1) << log2_capacity) * sizeof(T))};
+            auto memory = static_cast<T*>(guard.memory);
+
+            // construct the new element before relocating, the arguments might refer to an element
+            ::new (static_cast<void*>(memory + size())) T(std::forward<Args>(args)...);
+            vector_detail::relocate(data(), size(), memory, relocatable{});
+            guard.memory = nullptr;
+
+            if (is_heap())
+                std::free(heap_pointer());
+            set_heap(memory, log2_capacity);
+        }
+
+        void append(const compact_vector& other)
+        {
+            reserve(size() + other.size());
+            for (auto& element : other)
+                emplace_back(element);
+        }
+
+        // requires an empty vector using the inline storage
+        void steal(compact_vector& other) noexcept
+        {
+            if (other.is_heap())
+            {
+                std::memcpy(buffer_, other.buffer_, sizeof(buffer_));
+                header_ = other.header_;
+            }
+            else
+            {
+                vector_detail::relocate(other.data(), other.size(), data(), relocatable{});
+                set_size(other.size());
+            }
+
+            other.header_ = decltype(header_)(false, 0u, 0u);
+        }
+
+        alignas(T) alignas(void*) unsigned char buffer_[vector_detail::inline_bytes];
+        tiny_storage<tiny_bool, tiny_unsigned<vector_detail::capacity_bits>,
+                     tiny_unsigned<vector_detail::size_bits, std::uint32_t>>
+            header_;
+    };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::compact_vector]().
+    ///
+    /// It is trivially relocatable if the elements are, as they might be stored inline.
+    template <typename T>
+    struct is_trivially_relocatable<compact_vector<T>> : is_trivially_relocatable<T>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_COMPACT_VECTOR_HPP_INCLUDED
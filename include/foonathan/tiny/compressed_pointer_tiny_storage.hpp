@@ -0,0 +1,177 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_COMPRESSED_POINTER_TINY_STORAGE_HPP_INCLUDED
+#define FOONATHAN_TINY_COMPRESSED_POINTER_TINY_STORAGE_HPP_INCLUDED
+
+#include <cstdint>
+#include <type_traits>
+
+#include <foonathan/tiny/detail/ilog2.hpp>
+#include <foonathan/tiny/pointer_tiny_storage.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    namespace detail
+    {
+        template <std::size_t Alignment, class Arena, class... TinyTypes>
+        class compressed_pointer_storage_policy
+        {
+            static constexpr auto shift       = detail::ilog2(Alignment);
+            static constexpr auto tiny_size   = total_bit_size<TinyTypes...>();
+            static constexpr auto offset_size = 32u - tiny_size;
+            static_assert(tiny_size < 32u, "too many tiny types for a compressed pointer");
+
+            using offset_mask = std::integral_constant<std::uint32_t,
+                                                       std::uint32_t(all_bits_set(offset_size))>;
+
+            std::uint32_t storage_;
+
+        private:
+            using is_compressed = std::true_type;
+
+            compressed_pointer_storage_policy() noexcept = default;
+
+            bit_view<std::uint32_t, offset_size, last_bit> storage_view() noexcept
+            {
+                return make_bit_view<offset_size, last_bit>(storage_);
+            }
+            bit_view<const std::uint32_t, offset_size, last_bit> storage_view() const noexcept
+            {
+                return make_bit_view<offset_size, last_bit>(storage_);
+            }
+
+            static std::uintptr_t base() noexcept
+            {
+                return reinterpret_cast<std::uintptr_t>(Arena::base());
+            }
+
+            friend basic_tiny_storage<compressed_pointer_storage_policy<Alignment, Arena,
+                                                                        TinyTypes...>,
+                                      TinyTypes...>;
+
+        public:
+            // the offset is stored plus one, so zero is the null pointer
+            static constexpr std::uint64_t max_arena_size() noexcept
+            {
+                return std::uint64_t(offset_mask::value) << shift;
+            }
+
+            template <typename T>
+            void set_pointer(T* ptr) noexcept
+            {
+                std::uint32_t offset = 0;
+                if (ptr != nullptr)
+                {
+                    auto as_int = reinterpret_cast<std::uintptr_t>(ptr);
+                    DEBUG_ASSERT(as_int >= base() && as_int - base() < max_arena_size(),
+                                 detail::precondition_handler{}, "pointer not in arena");
+                    DEBUG_ASSERT((are_cleared_bits<0, shift>(as_int - base())),
+                                 detail::precondition_handler{}, "invalid alignment of pointer");
+                    offset = static_cast<std::uint32_t>(((as_int - base()) >> shift) + 1u);
+                }
+                storage_ = (storage_ & ~offset_mask::value) | offset;
+            }
+
+            template <typename T>
+            T* get_pointer() const noexcept
+            {
+                auto offset = storage_ & offset_mask::value;
+                if (offset == 0u)
+                    return nullptr;
+                return reinterpret_cast<T*>(base() + (std::uintptr_t(offset - 1u) << shift));
+            }
+        };
+    } // namespace detail
+
+    /// Stores a pointer to `T` into an arena and the specified tiny types in 32 bits.
+    ///
+    /// Instead of the full pointer it stores the offset from the start of the arena divided by
+    /// the alignment, like the compressed ordinary object pointers of the JVM,
+    /// and the tiny types in the remaining high bits.
+    /// With `N` bits of tiny types the arena can be up to `2^(32 - N) - 1` times the alignment
+    /// big, e.g. 32 GB for an alignment of 8 and no tiny types.
+    ///
+    /// `Arena` must have a static member function `base()` returning a pointer to the start of
+    /// the arena, which must not change while the storage is in use.
+    /// Pass [tiny::aligned_obj]() instead of `T` if you know that the object you need to point to
+    /// has a given over-alignment.
+    template <typename T, class Arena, typename... TinyTypes>
+    class compressed_pointer_tiny_storage
+    : public basic_tiny_storage<
+          detail::compressed_pointer_storage_policy<alignment_of<T>(), Arena, TinyTypes...>,
+          TinyTypes...>
+    {
+        static_assert(!std::is_same<typename std::remove_cv<T>::type, void>::value,
+                      "void pointers have no alignment, wrap them in aligned_obj instead");
+
+        using policy
+            = detail::compressed_pointer_storage_policy<alignment_of<T>(), Arena, TinyTypes...>;
+
+    public:
+        using value_type   = typename detail::alignment_traits<T>::type;
+        using pointer_type = value_type*;
+
+        /// Default constructor.
+        /// \effects Creates a storage where the pointer is `nullptr` and the tiny types have all
+        /// bits set to zero.
+        compressed_pointer_tiny_storage() noexcept
+        {
+            pointer() = nullptr;
+        }
+
+        /// \effects Creates a storage where the pointer is `ptr` and the tiny types have all bits
+        /// set to zero.
+        explicit compressed_pointer_tiny_storage(pointer_type ptr) noexcept
+        {
+            pointer() = ptr;
+        }
+
+        /// \effects Creates a storage where the pointer is `ptr` and the tiny types are created
+        /// from their object types.
+        /// \notes This constructor does not participate in overload resolution,
+        /// unless there are tiny types.
+        template <typename Dummy = void,
+                  typename = typename std::enable_if<sizeof...(TinyTypes) != 0, Dummy>::type>
+        compressed_pointer_tiny_storage(pointer_type ptr,
+                                        typename TinyTypes::object_type... tiny) noexcept
+        : basic_tiny_storage<policy, TinyTypes...>(tiny...)
+        {
+            pointer() = ptr;
+        }
+
+        /// \returns A proxy that behaves like a mutable reference to the stored pointer.
+        detail::pointer_proxy<value_type, policy> pointer() noexcept
+        {
+            return {0, &this->storage_policy()};
+        }
+        /// \returns The stored pointer.
+        pointer_type pointer() const noexcept
+        {
+            return this->storage_policy().template get_pointer<value_type>();
+        }
+
+        /// \returns The maximal size of the arena in bytes.
+        static constexpr std::uint64_t max_arena_size() noexcept
+        {
+            return policy::max_arena_size();
+        }
+    };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for
+    /// [tiny::compressed_pointer_tiny_storage]().
+    ///
+    /// It only stores an offset and bits, so it is always trivially relocatable.
+    template <typename T, class Arena, class... TinyTypes>
+    struct is_trivially_relocatable<compressed_pointer_tiny_storage<T, Arena, TinyTypes...>>
+    : std::true_type
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_COMPRESSED_POINTER_TINY_STORAGE_HPP_INCLUDED
@@ -0,0 +1,62 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_DETAIL_BIT_COUNT_HPP_INCLUDED
+#define FOONATHAN_TINY_DETAIL_BIT_COUNT_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+namespace foonathan
+{
+namespace tiny
+{
+    namespace detail
+    {
+        // number of set bits
+        inline std::size_t popcount(std::uint64_t x) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_popcountll(x));
+#else
+            // SWAR: sum of bits in pairs, nibbles, bytes, then add all bytes
+            x = x - ((x >> 1) & 0x5555555555555555u);
+            x = (x & 0x3333333333333333u) + ((x >> 2) & 0x3333333333333333u);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Fu;
+            return static_cast<std::size_t>((x * 0x0101010101010101u) >> 56);
+#endif
+        }
+
+        // index of the lowest set bit, undefined for 0
+        inline std::size_t count_trailing_zeros(std::uint64_t x) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_ctzll(x));
+#else
+            // isolate the lowest bit, the bits below it are exactly the trailing zeros
+            return popcount((x & (0u - x)) - 1u);
+#endif
+        }
+
+        // number of zero bits above the highest set bit, undefined for 0
+        inline std::size_t count_leading_zeros(std::uint64_t x) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<std::size_t>(__builtin_clzll(x));
+#else
+            // smear the highest bit to the right, the bits that are still zero are leading
+            x |= x >> 1;
+            x |= x >> 2;
+            x |= x >> 4;
+            x |= x >> 8;
+            x |= x >> 16;
+            x |= x >> 32;
+            return 64u - popcount(x);
+#endif
+        }
+    } // namespace detail
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_DETAIL_BIT_COUNT_HPP_INCLUDED
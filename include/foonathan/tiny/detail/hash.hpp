@@ -0,0 +1,31 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_DETAIL_HASH_HPP_INCLUDED
+#define FOONATHAN_TINY_DETAIL_HASH_HPP_INCLUDED
+
+#include <cstdint>
+
+namespace foonathan
+{
+namespace tiny
+{
+    namespace detail
+    {
+        // finalizer of splitmix64,
+        // spreads a hash value like std::hash<int>, which is often the identity, over all bits
+        inline std::uint64_t mix_hash(std::uint64_t x) noexcept
+        {
+            x ^= x >> 30;
+            x *= 0xBF58476D1CE4E5B9u;
+            x ^= x >> 27;
+            x *= 0x94D049BB133111EBu;
+            x ^= x >> 31;
+            return x;
+        }
+    } // namespace detail
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_DETAIL_HASH_HPP_INCLUDED
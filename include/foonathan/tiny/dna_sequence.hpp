@@ -0,0 +1,368 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_DNA_SEQUENCE_HPP_INCLUDED
+#define FOONATHAN_TINY_DNA_SEQUENCE_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/detail/bit_count.hpp>
+#include <foonathan/tiny/enum_traits.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// A nucleotide of a DNA sequence.
+    ///
+    /// The values are chosen so that they're bits 1 and 2 of the ASCII code (upper or lower case)
+    /// and the complement is obtained by flipping the higher bit.
+    enum class nucleotide : std::uint8_t
+    {
+        A = 0,
+        C = 1,
+        T = 2,
+        G = 3,
+    };
+
+    /// Specialization of the enum traits for [tiny::nucleotide](),
+    /// so a `tiny_enum<nucleotide>` takes two bits.
+    template <>
+    struct enum_traits<nucleotide> : enum_traits_unsigned<nucleotide, nucleotide::G>
+    {};
+
+    /// \returns The complement of the nucleotide, i.e. `A` and `T` resp. `C` and `G` are swapped.
+    constexpr nucleotide complement(nucleotide n) noexcept
+    {
+        return nucleotide(std::uint8_t(n) ^ 2u);
+    }
+
+    /// \exclude
+    namespace dna_detail
+    {
+        constexpr std::size_t bases_per_word = 32u;
+
+        constexpr std::uint64_t low_mask(std::size_t bits) noexcept
+        {
+            return bits >= 64u ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1u;
+        }
+
+        inline bool is_valid(const char* ascii, std::size_t size) noexcept
+        {
+            for (auto i = std::size_t(0); i != size; ++i)
+                switch (ascii[i])
+                {
+                case 'A':
+                case 'C':
+                case 'G':
+                case 'T':
+                case 'a':
+                case 'c':
+                case 'g':
+                case 't':
+                    break;
+                default:
+                    return false;
+                }
+            return true;
+        }
+
+        //=== SWAR conversion of eight bases ===//
+        inline std::uint64_t load_bytes(const char* ptr) noexcept
+        {
+            // assembled byte by byte, so it doesn't depend on endianness
+            // (compilers turn it into a single load)
+            std::uint64_t result = 0;
+            for (auto i = 0u; i != 8u; ++i)
+                result |= std::uint64_t(static_cast<unsigned char>(ptr[i])) << (8u * i);
+            return result;
+        }
+
+        inline void store_bytes(char* ptr, std::uint64_t bytes) noexcept
+        {
+            for (auto i = 0u; i != 8u; ++i)
+                ptr[i] = static_cast<char>(static_cast<unsigned char>(bytes >> (8u * i)));
+        }
+
+        // eight ASCII characters to 16 bits
+        inline std::uint64_t encode8(std::uint64_t chars) noexcept
+        {
+            auto codes = (chars >> 1) & 0x0303030303030303u;
+            // gather the codes of neighboring bytes, then 16 bit lanes, then 32 bit lanes
+            codes = (codes | (codes >> 6)) & 0x000F000F000F000Fu;
+            codes = (codes | (codes >> 12)) & 0x000000FF000000FFu;
+            return (codes | (codes >> 24)) & 0xFFFFu;
+        }
+
+        // 16 bits to eight upper case ASCII characters
+        inline std::uint64_t decode8(std::uint64_t bits) noexcept
+        {
+            // scatter the codes into separate bytes
+            auto codes = bits & 0xFFFFu;
+            codes      = (codes | (codes << 24)) & 0x000000FF000000FFu;
+            codes      = (codes | (codes << 12)) & 0x000F000F000F000Fu;
+            codes      = (codes | (codes << 6)) & 0x0303030303030303u;
+
+            // A = 0x41, C = 0x43, T = 0x54, G = 0x47,
+            // none of the operations carry or borrow into the next byte
+            constexpr std::uint64_t ones = 0x0101010101010101u;
+            auto                    low  = codes & ones;
+            auto                    high = (codes >> 1) & ones;
+            return 0x41 * ones + 0x02 * low + 0x13 * high - 0x0F * (low & high);
+        }
+
+        //=== word operations ===//
+        inline std::uint64_t byte_swap(std::uint64_t word) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_bswap64(word);
+#else
+            word = ((word >> 8) & 0x00FF00FF00FF00FFu) | ((word & 0x00FF00FF00FF00FFu) << 8);
+            word = ((word >> 16) & 0x0000FFFF0000FFFFu) | ((word & 0x0000FFFF0000FFFFu) << 16);
+            return (word >> 32) | (word << 32);
+#endif
+        }
+
+        // reverses the order of the bases in the word and complements them
+        inline std::uint64_t reverse_complement(std::uint64_t word) noexcept
+        {
+            word ^= 0xAAAAAAAAAAAAAAAAu;
+            // swap neighboring bases, then pairs of bases, then bytes
+            word = ((word >> 2) & 0x3333333333333333u) | ((word & 0x3333333333333333u) << 2);
+            word = ((word >> 4) & 0x0F0F0F0F0F0F0F0Fu) | ((word & 0x0F0F0F0F0F0F0F0Fu) << 4);
+            return byte_swap(word);
+        }
+    } // namespace dna_detail
+
+    /// A DNA sequence that stores each [tiny::nucleotide]() in two bits.
+    ///
+    /// The nucleotides are stored in a dynamically allocated array of 64 bit words, 32 per word,
+    /// so it takes a quarter of the memory of the ASCII characters.
+    /// Conversion from and to ASCII processes eight characters at once using SWAR,
+    /// reverse complement and Hamming distance work on whole words.
+    class dna_sequence
+    {
+    public:
+        using value_type = nucleotide;
+
+        //=== constructors ===//
+        /// \effects Creates an empty sequence.
+        dna_sequence() noexcept : size_(0u) {}
+
+        /// \effects Creates a sequence from the ASCII characters.
+        /// \requires All characters are one of `ACGTacgt`.
+        dna_sequence(const char* ascii, std::size_t size) : dna_sequence()
+        {
+            assign(ascii, size);
+        }
+
+        //=== modifiers ===//
+        /// \effects Replaces the sequence by the ASCII characters.
+        /// \requires All characters are one of `ACGTacgt`.
+        void assign(const char* ascii, std::size_t size)
+        {
+            DEBUG_ASSERT(dna_detail::is_valid(ascii, size), detail::precondition_handler{},
+                         "invalid nucleotide");
+
+            words_.assign(word_count(size), 0u);
+            auto full_words = size / dna_detail::bases_per_word;
+            for (auto i = std::size_t(0); i != full_words; ++i)
+            {
+                std::uint64_t word = 0;
+                for (auto j = 0u; j != 4u; ++j)
+                    word |= dna_detail::encode8(dna_detail::load_bytes(ascii + 8u * j))
+                            << (16u * j);
+                words_[i] = word;
+                ascii += dna_detail::bases_per_word;
+            }
+
+            size_ = size;
+            for (auto i = full_words * dna_detail::bases_per_word; i != size; ++i)
+                set(i, nucleotide((static_cast<unsigned char>(*ascii++) >> 1) & 3u));
+        }
+
+        /// \effects Appends the nucleotide.
+        void push_back(nucleotide n)
+        {
+            if (size_ % dna_detail::bases_per_word == 0u)
+                words_.push_back(0u);
+            ++size_;
+            set(size_ - 1u, n);
+        }
+
+        /// \effects Sets the nucleotide at the given position.
+        /// \requires `i < size()`.
+        void set(std::size_t i, nucleotide n) noexcept
+        {
+            DEBUG_ASSERT(i < size_, detail::precondition_handler{}, "index out of range");
+            auto& word  = words_[i / dna_detail::bases_per_word];
+            auto  shift = 2u * (i % dna_detail::bases_per_word);
+            word        = (word & ~(std::uint64_t(3) << shift)) | (std::uint64_t(n) << shift);
+        }
+
+        /// \effects Removes all nucleotides, but keeps the memory.
+        void clear() noexcept
+        {
+            words_.clear();
+            size_ = 0u;
+        }
+
+        /// \effects Reserves memory for the given number of nucleotides.
+        void reserve(std::size_t capacity)
+        {
+            words_.reserve(word_count(capacity));
+        }
+
+        //=== accessors ===//
+        /// \returns The nucleotide at the given position.
+        /// \requires `i < size()`.
+        nucleotide operator[](std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < size_, detail::precondition_handler{}, "index out of range");
+            return nucleotide((words_[i / dna_detail::bases_per_word]
+                               >> (2u * (i % dna_detail::bases_per_word)))
+                              & 3u);
+        }
+
+        /// \returns The number of nucleotides.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not the sequence is empty.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns The number of nucleotides it can store without allocating memory.
+        std::size_t capacity() const noexcept
+        {
+            return words_.capacity() * dna_detail::bases_per_word;
+        }
+
+        /// \effects Writes `size()` upper case ASCII characters to `out`.
+        /// \notes It does not write a null terminator.
+        void to_ascii(char* out) const noexcept
+        {
+            auto full_words = size_ / dna_detail::bases_per_word;
+            for (auto i = std::size_t(0); i != full_words; ++i)
+            {
+                for (auto j = 0u; j != 4u; ++j)
+                    dna_detail::store_bytes(out + 8u * j,
+                                            dna_detail::decode8(words_[i] >> (16u * j)));
+                out += dna_detail::bases_per_word;
+            }
+
+            for (auto i = full_words * dna_detail::bases_per_word; i != size_; ++i)
+                *out++ = "ACTG"[std::size_t((*this)[i])];
+        }
+
+        /// \returns The reverse complement of the sequence,
+        /// i.e. the sequence read backwards with each nucleotide complemented.
+        dna_sequence reverse_complement() const
+        {
+            dna_sequence result;
+            result.size_ = size_;
+            result.words_.resize(words_.size());
+
+            auto words = words_.size();
+            // reversing whole words moves the unused bits of the last word to the front,
+            // so they need to be shifted out
+            auto unused = 2u * (words * dna_detail::bases_per_word - size_);
+            for (auto i = std::size_t(0); i != words; ++i)
+            {
+                auto word = dna_detail::reverse_complement(words_[words - 1u - i]) >> unused;
+                if (unused != 0u && i + 1u != words)
+                    word |= dna_detail::reverse_complement(words_[words - 2u - i])
+                            << (64u - unused);
+                result.words_[i] = word;
+            }
+            return result;
+        }
+
+        /// \returns The `k`-mer starting at the given position as an integer of `2 * k` bits.
+        /// The first nucleotide is stored in the lowest two bits.
+        /// \requires `1 <= k <= 32` and `pos + k <= size()`.
+        std::uint64_t kmer(std::size_t pos, std::size_t k) const noexcept
+        {
+            DEBUG_ASSERT(1u <= k && k <= 32u && pos + k <= size_, detail::precondition_handler{},
+                         "invalid k-mer");
+            auto bit    = 2u * pos;
+            auto index  = bit / 64u;
+            auto offset = bit % 64u;
+
+            auto result = words_[index] >> offset;
+            if (offset + 2u * k > 64u)
+                result |= words_[index + 1u] << (64u - offset);
+            return result & dna_detail::low_mask(2u * k);
+        }
+
+        /// \effects Invokes `f(pos, kmer(pos, k))` for every position of a `k`-mer in order.
+        /// \notes Only the first `k`-mer is extracted, the following ones are computed by
+        /// shifting out the first nucleotide and shifting in the next one.
+        /// \requires `1 <= k <= 32`.
+        template <typename Func>
+        void for_each_kmer(std::size_t k, Func f) const
+        {
+            DEBUG_ASSERT(1u <= k && k <= 32u, detail::precondition_handler{}, "invalid k-mer");
+            if (k > size_)
+                return;
+
+            auto kmer = this->kmer(0u, k);
+            f(std::size_t(0), kmer);
+            for (auto next = k; next != size_; ++next)
+            {
+                auto base = (words_[next / dna_detail::bases_per_word]
+                             >> (2u * (next % dna_detail::bases_per_word)))
+                            & 3u;
+                kmer = (kmer >> 2) | (base << (2u * (k - 1u)));
+                f(next - k + 1u, kmer);
+            }
+        }
+
+        /// \returns The number of positions where the nucleotides of the sequences differ.
+        /// \requires Both sequences have the same size.
+        friend std::size_t hamming_distance(const dna_sequence& lhs,
+                                            const dna_sequence& rhs) noexcept
+        {
+            DEBUG_ASSERT(lhs.size_ == rhs.size_, detail::precondition_handler{},
+                         "sequences have different sizes");
+            std::size_t result = 0;
+            for (auto i = std::size_t(0); i != lhs.words_.size(); ++i)
+            {
+                // a base differs if either of its bits differs
+                auto difference = lhs.words_[i] ^ rhs.words_[i];
+                result += detail::popcount((difference | (difference >> 1)) & 0x5555555555555555u);
+            }
+            return result;
+        }
+
+        friend bool operator==(const dna_sequence& lhs, const dna_sequence& rhs) noexcept
+        {
+            return lhs.size_ == rhs.size_ && lhs.words_ == rhs.words_;
+        }
+        friend bool operator!=(const dna_sequence& lhs, const dna_sequence& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        static std::size_t word_count(std::size_t size) noexcept
+        {
+            return (size + dna_detail::bases_per_word - 1u) / dna_detail::bases_per_word;
+        }
+
+        // exactly the used words, their unused bits are always zero
+        std::vector<std::uint64_t> words_;
+        std::size_t                size_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_DNA_SEQUENCE_HPP_INCLUDED
@@ -9,6 +9,8 @@
 #include <type_traits>
 
 #include <foonathan/tiny/detail/ilog2.hpp>
+#include <foonathan/tiny/detail/index_sequence.hpp>
+#include <foonathan/tiny/detail/select_integer.hpp>
 
 namespace foonathan
 {
@@ -103,6 +105,179 @@ namespace tiny
         static constexpr auto is_contiguous = true;
     };
 
+    /// \exclude
+    namespace enum_traits_detail
+    {
+        template <typename Enum>
+        constexpr std::uintmax_t to_uint(Enum value) noexcept
+        {
+            return static_cast<std::uintmax_t>(
+                static_cast<typename std::underlying_type<Enum>::type>(value));
+        }
+
+        template <typename Enum>
+        constexpr bool is_sorted(Enum) noexcept
+        {
+            return true;
+        }
+        template <typename Enum, typename... Tail>
+        constexpr bool is_sorted(Enum a, Enum b, Tail... tail) noexcept
+        {
+            using underlying = typename std::underlying_type<Enum>::type;
+            return underlying(a) < underlying(b) && is_sorted(b, tail...);
+        }
+
+        // index of value in the list, or the size of the list if it isn't there
+        template <typename Enum>
+        constexpr std::size_t sparse_index_of(Enum, std::size_t index) noexcept
+        {
+            return index;
+        }
+        template <typename Enum, typename... Tail>
+        constexpr std::size_t sparse_index_of(Enum value, std::size_t index, Enum head,
+                                              Tail... tail) noexcept
+        {
+            return value == head ? index : sparse_index_of(value, index + 1u, tail...);
+        }
+
+        template <typename Enum, Enum... Values>
+        struct sparse_values
+        {
+            static constexpr Enum values[] = {Values...};
+
+            // values are sorted
+            static constexpr Enum min() noexcept
+            {
+                return values[0];
+            }
+            static constexpr Enum max() noexcept
+            {
+                return values[sizeof...(Values) - 1u];
+            }
+
+            // zero if it overflows
+            static constexpr std::uintmax_t range() noexcept
+            {
+                return to_uint(max()) - to_uint(min()) + 1u;
+            }
+        };
+
+        template <typename Enum, Enum... Values>
+        constexpr Enum sparse_values<Enum, Values...>::values[];
+
+        // a dense table mapping value - min to the index for small ranges
+        constexpr std::uintmax_t max_sparse_table_size = 256u;
+
+        template <std::uintmax_t Range, std::size_t Size>
+        struct use_sparse_table
+        : std::integral_constant<bool, Range != 0u
+                                           && (Range <= max_sparse_table_size || Range <= 4u * Size)>
+        {};
+
+        template <class Sequence, typename Enum, Enum... Values>
+        struct sparse_table;
+
+        template <std::size_t... Offsets, typename Enum, Enum... Values>
+        struct sparse_table<detail::index_sequence<Offsets...>, Enum, Values...>
+        {
+            using index_type = detail::uint_least_n_t<detail::ilog2_ceil(sizeof...(Values) + 1u)>;
+            using underlying = typename std::underlying_type<Enum>::type;
+
+            static constexpr index_type table[] = {index_type(sparse_index_of(
+                Enum(underlying(to_uint(sparse_values<Enum, Values...>::min()) + Offsets)), 0u,
+                Values...))...};
+        };
+
+        template <std::size_t... Offsets, typename Enum, Enum... Values>
+        constexpr typename sparse_table<detail::index_sequence<Offsets...>, Enum,
+                                        Values...>::index_type
+            sparse_table<detail::index_sequence<Offsets...>, Enum, Values...>::table[];
+    } // namespace enum_traits_detail
+
+    /// Enum traits implementation for an enum whose valid values are exactly `Values`,
+    /// which don't need to be contiguous.
+    ///
+    /// Each value is identified with its index in `Values`,
+    /// so a [tiny::tiny_enum]() only needs the bits to store the index.
+    /// The index is looked up in a table indexed by the value if the range of values is small,
+    /// otherwise using a binary search.
+    /// \requires `Values` must not be empty and sorted in ascending order.
+    template <typename Enum, Enum... Values>
+    struct enum_traits_sparse
+    {
+        static_assert(std::is_enum<Enum>::value, "not an enum");
+        static_assert(sizeof...(Values) > 0u, "no valid values");
+        static_assert(enum_traits_detail::is_sorted(Values...),
+                      "values must be sorted and unique");
+
+    private:
+        using values = enum_traits_detail::sparse_values<Enum, Values...>;
+
+        using use_table = enum_traits_detail::use_sparse_table<values::range(), sizeof...(Values)>;
+        using table     = enum_traits_detail::sparse_table<
+            typename detail::make_index_sequence<use_table::value ? std::size_t(values::range())
+                                                                  : 1u>::type,
+            Enum, Values...>;
+
+        static std::size_t index_of(std::true_type, Enum value) noexcept
+        {
+            auto offset
+                = enum_traits_detail::to_uint(value) - enum_traits_detail::to_uint(values::min());
+            return offset < values::range() ? std::size_t(table::table[offset]) : size();
+        }
+        static std::size_t index_of(std::false_type, Enum value) noexcept
+        {
+            using underlying = typename std::underlying_type<Enum>::type;
+
+            std::size_t begin = 0u, end = size();
+            while (begin != end)
+            {
+                auto middle = begin + (end - begin) / 2u;
+                if (underlying(values::values[middle]) < underlying(value))
+                    begin = middle + 1u;
+                else
+                    end = middle;
+            }
+            return begin != size() && values::values[begin] == value ? begin : size();
+        }
+
+    public:
+        using enum_type = Enum;
+
+        static constexpr auto is_specialized = true;
+
+        static constexpr Enum min() noexcept
+        {
+            return values::min();
+        }
+        static constexpr Enum max() noexcept
+        {
+            return values::max();
+        }
+
+        static constexpr auto is_contiguous = false;
+
+        /// \returns The number of valid enum values.
+        static constexpr std::size_t size() noexcept
+        {
+            return sizeof...(Values);
+        }
+
+        /// \returns The index of the given value in `Values`,
+        /// or `size()` if it isn't a valid enum value.
+        static std::size_t index_of(Enum value) noexcept
+        {
+            return index_of(use_table{}, value);
+        }
+
+        /// \returns The value with the given index in `Values`.
+        /// \requires `index < size()`.
+        static Enum value_at(std::size_t index) noexcept
+        {
+            return values::values[index];
+        }
+    };
+
     namespace enum_traits_detail
     {
         template <std::size_t>
@@ -181,18 +356,64 @@ namespace tiny
         typename enum_traits_detail::traits_of_impl<std::is_enum<EnumOrTraits>::value,
                                                     EnumOrTraits>::type;
 
+    /// \exclude
+    namespace enum_traits_detail
+    {
+        template <class Traits>
+        constexpr auto is_sparse_impl(int) -> decltype(Traits::value_at(0u), true)
+        {
+            return true;
+        }
+        template <class Traits>
+        constexpr bool is_sparse_impl(short)
+        {
+            return false;
+        }
+
+        template <class Traits>
+        struct is_sparse : std::integral_constant<bool, is_sparse_impl<Traits>(0)>
+        {};
+
+        template <class Traits>
+        constexpr std::size_t enum_size(std::true_type) noexcept
+        {
+            return Traits::size();
+        }
+        template <class Traits>
+        constexpr std::size_t enum_size(std::false_type) noexcept
+        {
+            static_assert(Traits::is_contiguous, "enum must be contiguous or sparse");
+            return std::size_t(Traits::max()) - std::size_t(Traits::min()) + 1;
+        }
+
+        template <class Traits, typename Enum>
+        bool is_valid_enum_value(std::true_type, Enum value) noexcept
+        {
+            return Traits::index_of(value) < Traits::size();
+        }
+        template <class Traits, typename Enum>
+        constexpr bool is_valid_enum_value(std::false_type, Enum value) noexcept
+        {
+            static_assert(Traits::is_contiguous, "enum must be contiguous or sparse");
+            using underlying = typename std::underlying_type<Enum>::type;
+            return underlying(Traits::min()) <= underlying(value)
+                   && underlying(value) <= underlying(Traits::max());
+        }
+    } // namespace enum_traits_detail
+
     /// \returns The size of an enum, that is the number of valid enum values.
-    /// \requires The enum must be contiguous.
+    /// \requires The enum must be contiguous or have sparse traits like
+    /// [tiny::enum_traits_sparse]().
     template <class EnumOrTraits>
     constexpr std::size_t enum_size() noexcept
     {
         using traits = traits_of_enum<EnumOrTraits>;
-        static_assert(traits::is_contiguous, "enum must be contiguous");
-        return std::size_t(traits::max()) - std::size_t(traits::min()) + 1;
+        return enum_traits_detail::enum_size<traits>(enum_traits_detail::is_sparse<traits>{});
     }
 
     /// \returns The number of bits required to store a valid enum value.
-    /// \requires The enum must be contiguous.
+    /// \requires The enum must be contiguous or have sparse traits like
+    /// [tiny::enum_traits_sparse]().
     template <class EnumOrTraits>
     constexpr std::size_t enum_bit_size() noexcept
     {
@@ -200,21 +421,21 @@ namespace tiny
     }
 
     /// \returns Whether or not the given enum value is a valid value.
-    /// \requires The enum must be contiguous.
+    /// \requires The enum must be contiguous or have sparse traits like
+    /// [tiny::enum_traits_sparse]().
+    /// \notes It is only `constexpr` for contiguous enums.
     /// \group is_valid_enum_value
-    template <typename Enum>
+    template <class Traits, typename Enum>
     constexpr bool is_valid_enum_value(Enum value) noexcept
     {
-        return is_valid_enum_value<enum_traits<Enum>>(value);
+        return enum_traits_detail::is_valid_enum_value<Traits>(
+            enum_traits_detail::is_sparse<Traits>{}, value);
     }
     /// \group is_valid_enum_value
-    template <class Traits, typename Enum>
+    template <typename Enum>
     constexpr bool is_valid_enum_value(Enum value) noexcept
     {
-        static_assert(Traits::is_contiguous, "enum must be contiguous");
-        using underlying = typename std::underlying_type<Enum>::type;
-        return underlying(Traits::min()) <= underlying(value)
-               && underlying(value) <= underlying(Traits::max());
+        return is_valid_enum_value<enum_traits<Enum>>(value);
     }
 } // namespace tiny
 } // namespace foonathan
@@ -0,0 +1,192 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_FREQUENCY_SKETCH_HPP_INCLUDED
+#define FOONATHAN_TINY_FREQUENCY_SKETCH_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+#include <foonathan/tiny/bit_view.hpp>
+#include <foonathan/tiny/detail/bit_count.hpp>
+#include <foonathan/tiny/detail/hash.hpp>
+#include <foonathan/tiny/detail/ilog2.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace sketch_detail
+    {
+        // a word consists of four 16 bit lanes of four 4 bit counters each
+        using counter = tiny_unsigned<4, std::uint64_t>;
+
+        constexpr std::size_t   lane_counters       = 4u;
+        constexpr std::size_t   word_counters       = 16u;
+        constexpr std::uint64_t lowest_counter_bits = 0x1111111111111111u;
+        constexpr std::uint64_t counter_max         = (1u << counter::bit_size()) - 1u;
+
+        // the value of the counter with the given index
+        inline std::uint64_t get_counter(std::uint64_t word, std::size_t index) noexcept
+        {
+            // move it to the lowest bits, so a single view works for all of them
+            auto shifted = word >> (index * counter::bit_size());
+            return make_tiny_proxy<counter>(
+                bit_view<const std::uint64_t, 0, counter::bit_size()>(shifted));
+        }
+
+        // the index of the counter of a hash in the given lane
+        inline std::size_t counter_index(std::uint64_t hash, std::size_t lane) noexcept
+        {
+            return lane * lane_counters + std::size_t((hash >> (2u * lane)) & 3u);
+        }
+
+        // the bits of the four counters of a hash in a word, one per lane
+        // each counter is represented by its lowest bit
+        inline std::uint64_t counter_bits(std::uint64_t hash) noexcept
+        {
+            std::uint64_t result = 0;
+            for (auto lane = 0u; lane != word_counters / lane_counters; ++lane)
+                result |= std::uint64_t(1) << (counter_index(hash, lane) * counter::bit_size());
+            return result;
+        }
+
+        // the minimum of the four counters of a hash
+        inline std::uint64_t min_counter(std::uint64_t word, std::uint64_t hash) noexcept
+        {
+            auto result = counter_max;
+            for (auto lane = 0u; lane != word_counters / lane_counters; ++lane)
+            {
+                auto value = get_counter(word, counter_index(hash, lane));
+                if (value < result)
+                    result = value;
+            }
+            return result;
+        }
+
+        // halves all counters of a word at once
+        inline std::uint64_t halve(std::uint64_t word) noexcept
+        {
+            // the lowest bit of a counter must not become the highest bit of the one below
+            return (word >> 1) & (~lowest_counter_bits >> 1);
+        }
+    } // namespace sketch_detail
+
+    /// A count-min sketch of 4 bit saturating counters that estimates the frequency of keys,
+    /// as used by the TinyLFU cache admission policy.
+    ///
+    /// It consists of `Size` 64 bit words, each containing sixteen 4 bit counters.
+    /// A key is identified by its hash, which selects one word and four counters in it,
+    /// so all operations only access a single word.
+    /// The counters are [tiny::tiny_unsigned]() values in a [tiny::bit_view]() of the word,
+    /// but increments and halving use SWAR to update all counters of a word at once.
+    /// Increments are conservative, i.e. only the minimal counters are incremented.
+    /// After [*sample_size]() increments all counters are halved,
+    /// so the sketch ages and keeps track of recent frequencies.
+    ///
+    /// Like [tiny::optional_array]() it does not allocate memory,
+    /// so big sketches should be allocated on the heap.
+    /// \requires `Size` must be a power of two.
+    template <std::size_t Size>
+    class frequency_sketch
+    {
+        static_assert(Size > 0u && detail::is_power_of_two(Size), "size must be a power of two");
+
+    public:
+        //=== constructors ===//
+        /// \effects Creates a sketch where all counters are zero.
+        frequency_sketch() noexcept : words_{}, additions_(0u) {}
+
+        //=== mutators ===//
+        /// \effects Increments the frequency of the key with the given hash,
+        /// unless it has already reached the maximum of 15.
+        /// If it is the [*sample_size]()-th increment, halves all frequencies afterwards.
+        void increment(std::size_t hash) noexcept
+        {
+            auto  mixed    = detail::mix_hash(hash);
+            auto& word     = words_[index_of(mixed)];
+            auto  counters = sketch_detail::counter_bits(mixed);
+
+            auto min = sketch_detail::min_counter(word, mixed);
+            if (min == sketch_detail::counter_max)
+                return;
+
+            // difference is zero for counters equal to the minimum
+            auto difference = (word ^ (counters * min)) & (counters * sketch_detail::counter_max);
+            // lowest bit of the counters that aren't equal
+            auto non_min = (difference | (difference >> 1) | (difference >> 2) | (difference >> 3))
+                           & counters;
+            // increment all the others, they can't overflow as they're less than the maximum
+            word += counters & ~non_min;
+
+            if (++additions_ == sample_size())
+                reset();
+        }
+
+        /// \effects Halves all frequencies.
+        /// \notes [*additions]() is halved as well,
+        /// after subtracting a quarter of the number of odd counters:
+        /// halving rounds them down, so each loses half an increment,
+        /// and an addition increments between one and four counters.
+        /// Like in Caffeine's implementation this is only an approximation.
+        void reset() noexcept
+        {
+            std::size_t odd = 0;
+            for (auto word : words_)
+                odd += detail::popcount(word & sketch_detail::lowest_counter_bits);
+
+            // independent shift-and-mask of every word, so compilers vectorize it
+            for (auto& word : words_)
+                word = sketch_detail::halve(word);
+
+            odd /= 4u;
+            additions_ = odd < additions_ ? (additions_ - odd) / 2u : 0u;
+        }
+
+        /// \effects Sets all frequencies to zero.
+        void clear() noexcept
+        {
+            for (auto& word : words_)
+                word = 0u;
+            additions_ = 0u;
+        }
+
+        //=== accessors ===//
+        /// \returns The estimated frequency of the key with the given hash, in the range `[0, 15]`.
+        /// \notes It is never less than the number of increments since the last reset,
+        /// unless the counter saturated.
+        std::size_t estimate(std::size_t hash) const noexcept
+        {
+            auto mixed = detail::mix_hash(hash);
+            return std::size_t(sketch_detail::min_counter(words_[index_of(mixed)], mixed));
+        }
+
+        /// \returns The number of increments after which all frequencies are halved.
+        static constexpr std::size_t sample_size() noexcept
+        {
+            return 10u * Size;
+        }
+
+        /// \returns The number of increments since the last reset, adjusted for the halving.
+        std::size_t additions() const noexcept
+        {
+            return additions_;
+        }
+
+    private:
+        static std::size_t index_of(std::uint64_t mixed) noexcept
+        {
+            // the lowest eight bits select the counters
+            return std::size_t(mixed >> 8) & (Size - 1u);
+        }
+
+        std::uint64_t words_[Size];
+        std::size_t   additions_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_FREQUENCY_SKETCH_HPP_INCLUDED
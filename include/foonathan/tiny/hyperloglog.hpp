@@ -0,0 +1,232 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_HYPERLOGLOG_HPP_INCLUDED
+#define FOONATHAN_TINY_HYPERLOGLOG_HPP_INCLUDED
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <foonathan/tiny/bit_view.hpp>
+#include <foonathan/tiny/detail/bit_count.hpp>
+#include <foonathan/tiny/detail/hash.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace hll_detail
+    {
+        constexpr std::size_t register_bits = 6u;
+        // four registers are packed into three bytes
+        constexpr std::size_t group_registers = 4u;
+        constexpr std::size_t group_bytes     = 3u;
+
+        template <typename Byte, std::size_t Index>
+        using register_view
+            = bit_view<Byte[group_bytes], Index * register_bits, (Index + 1u) * register_bits>;
+
+        template <typename Byte>
+        std::uintmax_t extract_register(Byte* group, std::size_t index) noexcept
+        {
+            switch (index)
+            {
+            case 0:
+                return register_view<Byte, 0>(group).extract();
+            case 1:
+                return register_view<Byte, 1>(group).extract();
+            case 2:
+                return register_view<Byte, 2>(group).extract();
+            default:
+                return register_view<Byte, 3>(group).extract();
+            }
+        }
+
+        inline void put_register(unsigned char* group, std::size_t index,
+                                 std::uintmax_t value) noexcept
+        {
+            switch (index)
+            {
+            case 0:
+                register_view<unsigned char, 0>(group).put(value);
+                break;
+            case 1:
+                register_view<unsigned char, 1>(group).put(value);
+                break;
+            case 2:
+                register_view<unsigned char, 2>(group).put(value);
+                break;
+            default:
+                register_view<unsigned char, 3>(group).put(value);
+                break;
+            }
+        }
+
+        //=== SWAR on two groups ===//
+        // two groups are eight registers in six bytes,
+        // they're unpacked to one register per byte of a 64 bit integer
+        constexpr std::size_t chunk_bytes     = 2u * group_bytes;
+        constexpr std::size_t chunk_registers = 2u * group_registers;
+
+        inline std::uint64_t load_chunk(const unsigned char* bytes) noexcept
+        {
+            // same bit order as bit_view, compilers turn it into plain loads
+            std::uint64_t result = 0;
+            for (auto i = 0u; i != chunk_bytes; ++i)
+                result |= std::uint64_t(bytes[i]) << (8u * i);
+            return result;
+        }
+
+        inline void store_chunk(unsigned char* bytes, std::uint64_t chunk) noexcept
+        {
+            for (auto i = 0u; i != chunk_bytes; ++i)
+                bytes[i] = static_cast<unsigned char>(chunk >> (8u * i));
+        }
+
+        inline std::uint64_t unpack(std::uint64_t chunk) noexcept
+        {
+            std::uint64_t result = 0;
+            for (auto i = 0u; i != chunk_registers; ++i)
+                result |= ((chunk >> (register_bits * i)) & 0x3Fu) << (8u * i);
+            return result;
+        }
+
+        inline std::uint64_t pack(std::uint64_t unpacked) noexcept
+        {
+            std::uint64_t result = 0;
+            for (auto i = 0u; i != chunk_registers; ++i)
+                result |= ((unpacked >> (8u * i)) & 0x3Fu) << (register_bits * i);
+            return result;
+        }
+
+        // bytewise maximum, requires that the highest bit of every byte is zero
+        inline std::uint64_t bytewise_max(std::uint64_t a, std::uint64_t b) noexcept
+        {
+            constexpr std::uint64_t high_bits = 0x8080808080808080u;
+            // a byte of a | high is always bigger than the byte of b, so there is no borrow,
+            // and the high bit stays set if a >= b
+            auto a_greater_equal = ((a | high_bits) - b) & high_bits;
+            auto mask            = (a_greater_equal >> 7) * 0xFFu;
+            return (a & mask) | (b & ~mask);
+        }
+
+        constexpr double alpha(std::size_t m) noexcept
+        {
+            return m == 16u
+                       ? 0.673
+                       : m == 32u ? 0.697 : m == 64u ? 0.709 : 0.7213 / (1. + 1.079 / double(m));
+        }
+    } // namespace hll_detail
+
+    /// A HyperLogLog sketch that estimates the number of distinct elements.
+    ///
+    /// It has `2^Precision` 6 bit registers, which are packed four per three bytes,
+    /// so it takes `0.75 * 2^Precision` bytes.
+    /// The relative standard error of the estimate is about `1.04 / sqrt(2^Precision)`.
+    /// Elements are identified by their hash.
+    ///
+    /// Merging and estimation unpack eight registers at a time into the bytes of a 64 bit integer
+    /// and process them using SWAR.
+    /// \requires `Precision` must be in the range `[4, 16]`.
+    template <std::size_t Precision>
+    class hyperloglog
+    {
+        static_assert(Precision >= 4u && Precision <= 16u, "invalid precision");
+
+        static constexpr std::size_t register_count = std::size_t(1) << Precision;
+        static constexpr std::size_t byte_count
+            = register_count / hll_detail::group_registers * hll_detail::group_bytes;
+
+    public:
+        //=== constructors ===//
+        /// \effects Creates an empty sketch.
+        hyperloglog() noexcept : registers_{} {}
+
+        //=== mutators ===//
+        /// \effects Adds the element with the given hash.
+        void add(std::size_t hash) noexcept
+        {
+            auto mixed = detail::mix_hash(hash);
+            auto index = std::size_t(mixed >> (64u - Precision));
+            // the sentinel bit limits the rank to 64 - Precision + 1, so it fits in a register
+            auto rest = (mixed << Precision) | (std::uint64_t(1) << (Precision - 1u));
+            auto rank = detail::count_leading_zeros(rest) + 1u;
+
+            auto group = registers_ + index / hll_detail::group_registers * hll_detail::group_bytes;
+            if (rank > hll_detail::extract_register(group, index % hll_detail::group_registers))
+                hll_detail::put_register(group, index % hll_detail::group_registers, rank);
+        }
+
+        /// \effects Merges the other sketch into this one,
+        /// so it estimates the number of elements in the union.
+        void merge(const hyperloglog& other) noexcept
+        {
+            for (auto i = std::size_t(0); i != byte_count; i += hll_detail::chunk_bytes)
+            {
+                auto lhs = hll_detail::unpack(hll_detail::load_chunk(registers_ + i));
+                auto rhs = hll_detail::unpack(hll_detail::load_chunk(other.registers_ + i));
+                hll_detail::store_chunk(registers_ + i,
+                                        hll_detail::pack(hll_detail::bytewise_max(lhs, rhs)));
+            }
+        }
+
+        /// \effects Removes all elements.
+        void clear() noexcept
+        {
+            for (auto& byte : registers_)
+                byte = 0u;
+        }
+
+        //=== accessors ===//
+        /// \returns The estimated number of distinct elements.
+        double estimate() const noexcept
+        {
+            // histogram of the register values
+            std::size_t histogram[64] = {};
+            for (auto i = std::size_t(0); i != byte_count; i += hll_detail::chunk_bytes)
+            {
+                auto chunk = hll_detail::unpack(hll_detail::load_chunk(registers_ + i));
+                for (auto j = 0u; j != hll_detail::chunk_registers; ++j)
+                    ++histogram[(chunk >> (8u * j)) & 0x3Fu];
+            }
+
+            auto sum = 0.;
+            for (auto rank = 0u; rank != 64u; ++rank)
+                sum += std::ldexp(double(histogram[rank]), -int(rank));
+
+            auto m        = double(register_count);
+            auto estimate = hll_detail::alpha(register_count) * m * m / sum;
+            if (estimate <= 2.5 * m && histogram[0] != 0u)
+                // linear counting for small cardinalities
+                return m * std::log(m / double(histogram[0]));
+            else
+                return estimate;
+        }
+
+        /// \returns The number of registers.
+        static constexpr std::size_t size() noexcept
+        {
+            return register_count;
+        }
+
+        /// \returns The value of the specified register.
+        /// \requires `index < size()`.
+        std::size_t operator[](std::size_t index) const noexcept
+        {
+            DEBUG_ASSERT(index < register_count, detail::precondition_handler{},
+                         "index out of range");
+            auto group = registers_ + index / hll_detail::group_registers * hll_detail::group_bytes;
+            return std::size_t(
+                hll_detail::extract_register(group, index % hll_detail::group_registers));
+        }
+
+    private:
+        unsigned char registers_[byte_count];
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_HYPERLOGLOG_HPP_INCLUDED
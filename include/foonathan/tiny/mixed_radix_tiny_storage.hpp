@@ -0,0 +1,390 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_MIXED_RADIX_TINY_STORAGE_HPP_INCLUDED
+#define FOONATHAN_TINY_MIXED_RADIX_TINY_STORAGE_HPP_INCLUDED
+
+#include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace mixed_radix_detail
+    {
+        //=== radix calculation ===//
+        template <class TinyType>
+        constexpr std::uintmax_t radix_of() noexcept
+        {
+            return tiny_max_encoding<TinyType>() + 1u;
+        }
+
+        // zero on overflow
+        constexpr std::uintmax_t checked_multiply(std::uintmax_t a, std::uintmax_t b) noexcept
+        {
+            return a == 0u || b == 0u || a > std::uintmax_t(-1) / b ? 0u : a * b;
+        }
+
+        template <class... TinyTypes>
+        struct radix_product;
+
+        template <>
+        struct radix_product<> : std::integral_constant<std::uintmax_t, 1u>
+        {};
+
+        template <class Head, class... Tail>
+        struct radix_product<Head, Tail...>
+        : std::integral_constant<std::uintmax_t,
+                                 checked_multiply(radix_of<Head>(),
+                                                  radix_product<Tail...>::value)>
+        {};
+
+        // number of bits required to store values in the range [0, n]
+        constexpr std::size_t bit_width(std::uintmax_t n) noexcept
+        {
+            return n == 0u ? 0u : 1u + bit_width(n >> 1);
+        }
+
+        //=== digit lookup ===//
+        // finds the tiny type viewing [Begin, End) and the product of the radices before it,
+        // radix is zero if there is none
+        template <std::size_t Begin, std::size_t End, std::size_t CurOffset,
+                  std::uintmax_t CurWeight, class... TinyTypes>
+        struct find_digit
+        {
+            static constexpr std::uintmax_t weight() noexcept
+            {
+                return 0u;
+            }
+            static constexpr std::uintmax_t radix() noexcept
+            {
+                return 0u;
+            }
+        };
+
+        template <std::size_t Begin, std::size_t End, std::size_t CurOffset,
+                  std::uintmax_t CurWeight, class Head, class... Tail>
+        struct find_digit<Begin, End, CurOffset, CurWeight, Head, Tail...>
+        {
+            static constexpr bool found
+                = Begin == CurOffset && End == CurOffset + Head::bit_size();
+            using recurse = find_digit<Begin, End, CurOffset + Head::bit_size(),
+                                       CurWeight * radix_of<Head>(), Tail...>;
+
+            static constexpr std::uintmax_t weight() noexcept
+            {
+                return found ? CurWeight : recurse::weight();
+            }
+            static constexpr std::uintmax_t radix() noexcept
+            {
+                return found ? radix_of<Head>() : recurse::radix();
+            }
+        };
+
+        //=== digit_reference ===//
+        template <class DigitView>
+        class digit_reference
+        {
+        public:
+            explicit digit_reference(DigitView view, std::size_t index) noexcept
+            : view_(view), index_(index)
+            {}
+
+            explicit operator bool() const noexcept
+            {
+                return ((view_.extract() >> index_) & 1u) != 0u;
+            }
+
+            const digit_reference& operator=(bool value) const noexcept
+            {
+                auto digit = view_.extract() & ~(std::uintmax_t(1) << index_);
+                view_.put(digit | (std::uintmax_t(value) << index_));
+                return *this;
+            }
+
+            friend bool operator==(const digit_reference& lhs, bool rhs) noexcept
+            {
+                return !!lhs == rhs;
+            }
+            friend bool operator!=(const digit_reference& lhs, bool rhs) noexcept
+            {
+                return !!lhs != rhs;
+            }
+
+            friend bool operator==(bool lhs, const digit_reference& rhs) noexcept
+            {
+                return lhs == !!rhs;
+            }
+            friend bool operator!=(bool lhs, const digit_reference& rhs) noexcept
+            {
+                return lhs != !!rhs;
+            }
+
+        private:
+            DigitView   view_;
+            std::size_t index_;
+        };
+    } // namespace mixed_radix_detail
+
+    /// Tag type to create a view to a digit of a mixed radix number.
+    template <class BitView, std::uintmax_t Weight, std::uintmax_t Radix>
+    struct mixed_radix_digit_tag
+    {};
+
+    /// Specialization for a bit view that views the digit with the given `Weight` and `Radix`
+    /// of the number stored in `BitView`.
+    ///
+    /// It has `End - Begin` bits and extracts and puts the encoding of a tiny type,
+    /// which must be less than `Radix`.
+    /// \notes It is not meant to be used directly, it is created by
+    /// [tiny::mixed_radix_tiny_storage]().
+    template <class BitView, std::uintmax_t Weight, std::uintmax_t Radix, std::size_t Begin,
+              std::size_t End>
+    class bit_view<mixed_radix_digit_tag<BitView, Weight, Radix>, Begin, End>
+    {
+        using is_const = typename BitView::is_const;
+
+    public:
+        /// \returns The number of bits.
+        static constexpr std::size_t size() noexcept
+        {
+            return End - Begin;
+        }
+
+        /// \effects Creates a view to the digit of the number viewed by `number`.
+        explicit bit_view(BitView number) noexcept : number_(number) {}
+
+        /// \effects Creates a view from the non-const version.
+        template <class OtherBitView,
+                  typename = typename std::enable_if<
+                      std::is_constructible<BitView, OtherBitView>::value>::type>
+        bit_view(bit_view<mixed_radix_digit_tag<OtherBitView, Weight, Radix>, Begin, End>
+                     other) noexcept
+        : number_(other.number_)
+        {}
+
+        /// \returns A boolean reference to the given bit of the digit.
+        /// \requires `i < size()`.
+        auto operator[](std::size_t i) const noexcept -> typename std::conditional<
+            is_const::value, bool, mixed_radix_detail::digit_reference<bit_view>>::type
+        {
+            DEBUG_ASSERT(i < size(), detail::precondition_handler{}, "index out of range");
+            using result = typename std::conditional<
+                is_const::value, bool, mixed_radix_detail::digit_reference<bit_view>>::type;
+            return result(mixed_radix_detail::digit_reference<bit_view>(*this, i));
+        }
+
+        /// \returns The digit.
+        std::uintmax_t extract() const noexcept
+        {
+            return (number_.extract() / Weight) % Radix;
+        }
+
+        /// \effects Sets the digit to the `size()` lower bits of `bits`.
+        /// \requires The digit must be less than `Radix`.
+        void put(std::uintmax_t bits) const noexcept
+        {
+            auto digit = bits & detail::all_bits_set(size());
+            DEBUG_ASSERT(digit < Radix, detail::precondition_handler{},
+                         "digit out of range for radix");
+
+            auto number = number_.extract();
+            number -= ((number / Weight) % Radix) * Weight;
+            number_.put(number + digit * Weight);
+        }
+
+    private:
+        BitView number_;
+
+        template <typename, std::size_t, std::size_t>
+        friend class bit_view;
+    };
+
+    /// Tag type to view multiple tiny types stored as digits of a mixed radix number.
+    template <class BitView, class... TinyTypes>
+    struct mixed_radix_tag
+    {};
+
+    /// Specialization for a bit view that views the tiny types as digits of a mixed radix number
+    /// stored in `BitView`.
+    ///
+    /// The indices are the ones of a [tiny::tiny_storage]() storing the same types,
+    /// but only subviews of a single tiny type or the spare bits are allowed.
+    /// \notes It is not meant to be used directly, it is created by
+    /// [tiny::mixed_radix_tiny_storage]().
+    template <class BitView, class... TinyTypes, std::size_t Begin, std::size_t End>
+    class bit_view<mixed_radix_tag<BitView, TinyTypes...>, Begin, End>
+    {
+        static constexpr auto product = mixed_radix_detail::radix_product<TinyTypes...>::value;
+        static_assert(product != 0u, "too many states to store in an integer");
+
+        static constexpr auto number_size = mixed_radix_detail::bit_width(product - 1u);
+        static_assert(number_size <= BitView::size(), "bit view overflow");
+
+        using number_view = decltype(std::declval<BitView>().template subview<0, number_size>());
+
+        template <std::size_t SubBegin, std::size_t SubEnd>
+        using digit = mixed_radix_detail::find_digit<SubBegin, SubEnd, 0, 1u, TinyTypes...>;
+
+        template <std::size_t SubBegin, std::size_t SubEnd>
+        using digit_view
+            = bit_view<mixed_radix_digit_tag<number_view, digit<SubBegin, SubEnd>::weight(),
+                                             digit<SubBegin, SubEnd>::radix()>,
+                       SubBegin, SubEnd>;
+
+        using spare_view
+            = decltype(std::declval<BitView>().template subview<number_size, last_bit>());
+
+        template <std::size_t SubBegin, std::size_t SubEnd,
+                  typename = typename std::enable_if<SubEnd != last_bit>::type>
+        digit_view<SubBegin, SubEnd> subview_impl(int) const noexcept
+        {
+            static_assert(digit<SubBegin, SubEnd>::radix() != 0u, "subview isn't a tiny type");
+            return digit_view<SubBegin, SubEnd>(number_.template subview<0, number_size>());
+        }
+        template <std::size_t SubBegin, std::size_t SubEnd,
+                  typename = typename std::enable_if<SubEnd == last_bit>::type>
+        spare_view subview_impl(short) const noexcept
+        {
+            static_assert(SubBegin == size(), "subview isn't a tiny type");
+            return number_.template subview<number_size, last_bit>();
+        }
+
+    public:
+        /// \returns The number of bits the tiny types would need if stored in a
+        /// [tiny::tiny_storage]().
+        static constexpr std::size_t size() noexcept
+        {
+            return End - Begin;
+        }
+
+        /// \returns The number of bits the mixed radix number needs.
+        static constexpr std::size_t number_bit_size() noexcept
+        {
+            return number_size;
+        }
+
+        /// \effects Creates a view to the number viewed by `number`.
+        explicit bit_view(BitView number) noexcept : number_(number) {}
+
+        /// \effects Creates a view from the non-const version.
+        template <class OtherBitView,
+                  typename = typename std::enable_if<
+                      std::is_constructible<BitView, OtherBitView>::value>::type>
+        bit_view(bit_view<mixed_radix_tag<OtherBitView, TinyTypes...>, Begin, End> other) noexcept
+        : number_(other.number_)
+        {}
+
+        /// \returns A view to the digit of the tiny type viewing `[SubBegin, SubEnd)`,
+        /// or the bits of `BitView` that are not needed for the number if `SubBegin == size()`
+        /// and `SubEnd == last_bit`.
+        template <std::size_t SubBegin, std::size_t SubEnd>
+        auto subview() const noexcept -> decltype(subview_impl<SubBegin, SubEnd>(0))
+        {
+            return subview_impl<SubBegin, SubEnd>(0);
+        }
+
+        /// \returns A view to the number.
+        number_view number() const noexcept
+        {
+            return number_.template subview<0, number_size>();
+        }
+
+        /// \returns A view to all bits.
+        BitView bits() const noexcept
+        {
+            return number_;
+        }
+
+    private:
+        BitView number_;
+
+        template <typename, std::size_t, std::size_t>
+        friend class bit_view;
+    };
+
+    /// \effects Clears all bits of the number, i.e. sets all digits to zero,
+    /// and the bits not used by it.
+    template <class BitView, class... TinyTypes, std::size_t Begin, std::size_t End>
+    void clear_bits(bit_view<mixed_radix_tag<BitView, TinyTypes...>, Begin, End> view) noexcept
+    {
+        clear_bits(view.bits());
+    }
+
+    /// \returns The number of bits required to store all the tiny types as digits of a mixed radix
+    /// number.
+    ///
+    /// It is the binary logarithm of the product of the number of encodings of each tiny type,
+    /// rounded up.
+    template <class... TinyTypes>
+    constexpr std::size_t mixed_radix_bit_size() noexcept
+    {
+        return mixed_radix_detail::bit_width(mixed_radix_detail::radix_product<TinyTypes...>::value
+                                             - 1u);
+    }
+
+    namespace mixed_radix_detail
+    {
+        template <class... TinyTypes>
+        class mixed_radix_storage_policy
+        {
+            using is_compressed = std::false_type;
+
+            mixed_radix_storage_policy() noexcept = default;
+
+            using storage_type = tiny_storage_type<mixed_radix_bit_size<TinyTypes...>()>;
+
+            template <class BitView>
+            using view_for
+                = bit_view<mixed_radix_tag<BitView, TinyTypes...>, 0, total_bit_size<TinyTypes...>()>;
+
+            view_for<bit_view<storage_type, 0, last_bit>> storage_view() noexcept
+            {
+                return view_for<bit_view<storage_type, 0, last_bit>>(
+                    make_bit_view<0, last_bit>(storage_));
+            }
+            view_for<bit_view<const storage_type, 0, last_bit>> storage_view() const noexcept
+            {
+                return view_for<bit_view<const storage_type, 0, last_bit>>(
+                    make_bit_view<0, last_bit>(storage_));
+            }
+
+            storage_type storage_;
+
+            friend basic_tiny_storage<mixed_radix_storage_policy<TinyTypes...>, TinyTypes...>;
+        };
+    } // namespace mixed_radix_detail
+
+    /// A compressed tuple of tiny types that stores them as digits of a mixed radix number.
+    ///
+    /// Every tiny type is a digit whose radix is the number of its encodings,
+    /// as given by [tiny::tiny_max_encoding]().
+    /// So five `tiny_int_range<0, 4>` only need 12 bits instead of 15 bits.
+    /// Accessing a tiny type requires a division and a multiplication by a constant,
+    /// so it is a bit slower than [tiny::tiny_storage]().
+    /// \requires The number of states of all tiny types together must fit into a
+    /// [std::uintmax_t]().
+    template <class... TinyTypes>
+    class mixed_radix_tiny_storage
+    : public basic_tiny_storage<mixed_radix_detail::mixed_radix_storage_policy<TinyTypes...>,
+                                TinyTypes...>
+    {
+    public:
+        using basic_tiny_storage<mixed_radix_detail::mixed_radix_storage_policy<TinyTypes...>,
+                                 TinyTypes...>::basic_tiny_storage;
+    };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for
+    /// [tiny::mixed_radix_tiny_storage]().
+    ///
+    /// It only stores bits, so it is always trivially relocatable.
+    template <class... TinyTypes>
+    struct is_trivially_relocatable<mixed_radix_tiny_storage<TinyTypes...>> : std::true_type
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_MIXED_RADIX_TINY_STORAGE_HPP_INCLUDED
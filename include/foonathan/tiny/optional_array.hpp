@@ -0,0 +1,370 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_OPTIONAL_ARRAY_HPP_INCLUDED
+#define FOONATHAN_TINY_OPTIONAL_ARRAY_HPP_INCLUDED
+
+#include <cstdint>
+#include <type_traits>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/detail/bit_count.hpp>
+#include <foonathan/tiny/tombstone.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace opt_array_detail
+    {
+        // number of slots whose presence is computed at once
+        constexpr std::size_t block_size = 64u;
+
+        constexpr std::size_t block_count(std::size_t size) noexcept
+        {
+            return (size + block_size - 1u) / block_size;
+        }
+
+        // loads up to eight bytes, the byte at begin[i] becomes the i-th lowest byte
+        // (assembled byte by byte, so it doesn't depend on endianness,
+        // compilers turn it into a single load)
+        inline std::uint64_t load_bytes(const unsigned char* begin, std::size_t size) noexcept
+        {
+            std::uint64_t result = 0;
+            for (auto i = 0u; i != size; ++i)
+                result |= std::uint64_t(begin[i]) << (i * 8u);
+            return result;
+        }
+
+        // gathers the lowest bit of each byte into the lowest byte,
+        // all other bits of the bytes must be zero
+        constexpr std::uint64_t gather_low_bits(std::uint64_t bytes) noexcept
+        {
+            return (bytes * 0x0102040810204080u) >> 56;
+        }
+
+        // computes the presence mask of [begin, begin + size), size <= block_size
+        // generic version: one slot at a time, but without branches
+        template <typename T>
+        struct presence_scanner
+        {
+            using traits = tombstone_traits<T>;
+
+            static std::uint64_t scan(const typename traits::storage_type* begin,
+                                      std::size_t                          size) noexcept
+            {
+                std::uint64_t mask = 0;
+                for (auto i = 0u; i != size; ++i)
+                {
+                    auto present = traits::get_tombstone(begin[i]) != traits::tombstone_count - 1u;
+                    mask |= std::uint64_t(present) << i;
+                }
+                return mask;
+            }
+        };
+
+        // pointer version: compares the integer storage with the empty tombstone
+        template <typename T>
+        struct presence_scanner<T*>
+        {
+            using traits = tombstone_traits<T*>;
+
+            static std::uint64_t scan(const typename traits::storage_type* begin,
+                                      std::size_t                          size) noexcept
+            {
+                typename traits::storage_type empty;
+                traits::create_tombstone(empty, traits::tombstone_count - 1u);
+
+                // a plain compare loop without dependencies between the iterations,
+                // compilers vectorize it if there is a 64 bit compare (e.g. SSE4.1 or NEON)
+                unsigned char present[block_size];
+                for (auto i = 0u; i != size; ++i)
+                    present[i] = begin[i] != empty;
+
+                // then pack eight flags at a time
+                std::uint64_t mask = 0;
+                for (auto i = 0u; i < size; i += 8u)
+                {
+                    auto rest = size - i < 8u ? size - i : 8u;
+                    mask |= gather_low_bits(load_bytes(present + i, rest)) << i;
+                }
+                return mask;
+            }
+        };
+
+        // bool version: eight slots at a time
+        template <>
+        struct presence_scanner<bool>
+        {
+            // one bit per byte, set if the byte is either 0 or 1
+            static std::uint64_t scan_bytes(std::uint64_t bytes) noexcept
+            {
+                // a present bool has bit pattern 0 or 1,
+                // a tombstone stores the index in the higher bits
+                auto x = bytes & 0xFEFEFEFEFEFEFEFEu;
+
+                // high bit of each byte is set iff the byte is zero
+                auto low_bits = 0x7F7F7F7F7F7F7F7Fu;
+                auto zero     = ~(((x & low_bits) + low_bits) | x | low_bits);
+
+                return gather_low_bits(zero >> 7);
+            }
+
+            static std::uint64_t scan(const bool* begin, std::size_t size) noexcept
+            {
+                auto bytes = reinterpret_cast<const unsigned char*>(begin);
+
+                std::uint64_t mask = 0;
+
+                auto i = 0u;
+                for (; i + 8u <= size; i += 8u)
+                    mask |= scan_bytes(load_bytes(bytes + i, 8u)) << i;
+
+                if (i != size)
+                {
+                    auto rest = size - i;
+                    // ignore the bytes that have not been loaded
+                    mask |= (scan_bytes(load_bytes(bytes + i, rest)) & ((1u << rest) - 1u)) << i;
+                }
+
+                return mask;
+            }
+        };
+
+        template <typename T, std::size_t Size>
+        class compressed_optional_array
+        {
+            using traits = tombstone_traits<T>;
+
+        public:
+            typename traits::storage_type storage[Size];
+
+            static constexpr std::size_t empty_tombstone() noexcept
+            {
+                return traits::tombstone_count - 1u;
+            }
+
+            void store_value_flag(std::size_t) noexcept {}
+
+            void store_none_flag(std::size_t index) noexcept
+            {
+                traits::create_tombstone(storage[index], empty_tombstone());
+            }
+
+            bool has_value(std::size_t index) const noexcept
+            {
+                return traits::get_tombstone(storage[index]) != empty_tombstone();
+            }
+
+            std::uint64_t presence_mask(std::size_t block) const noexcept
+            {
+                auto begin = block * block_size;
+                auto size  = Size - begin < block_size ? Size - begin : block_size;
+                return presence_scanner<T>::scan(storage + begin, size);
+            }
+        };
+
+        template <typename T, std::size_t Size>
+        class uncompressed_optional_array
+        {
+            using traits = tombstone_traits<T>;
+
+        public:
+            typename traits::storage_type storage[Size];
+            // the presence masks are stored directly
+            std::uint64_t flags[block_count(Size)] = {};
+
+            void store_value_flag(std::size_t index) noexcept
+            {
+                flags[index / block_size] |= std::uint64_t(1) << (index % block_size);
+            }
+
+            void store_none_flag(std::size_t index) noexcept
+            {
+                flags[index / block_size] &= ~(std::uint64_t(1) << (index % block_size));
+            }
+
+            bool has_value(std::size_t index) const noexcept
+            {
+                return (flags[index / block_size] >> (index % block_size)) & 1u;
+            }
+
+            std::uint64_t presence_mask(std::size_t block) const noexcept
+            {
+                return flags[block];
+            }
+        };
+    } // namespace opt_array_detail
+
+    /// A fixed-size array of optional values that uses tombstones whenever possible.
+    ///
+    /// It stores the `tombstone_traits<T>::storage_type` of each element contiguously,
+    /// an empty slot is marked with a tombstone just like in [tiny::optional_impl]().
+    /// If `T` does not have tombstones, the presence flags are stored as a separate bitmask.
+    ///
+    /// The bulk operations compute the presence of a whole block of slots at once,
+    /// which is considerably faster for sparse arrays than checking each slot individually.
+    /// For `bool` eight slots are tested with a single word operation,
+    /// for pointers the storage is compared with the empty tombstone in a loop that compilers
+    /// vectorize if the target has a 64 bit vector compare,
+    /// other types use a branch-free loop.
+    ///
+    /// Like [tiny::optional_impl]() it is a low-level implementation helper.
+    template <typename T, std::size_t Size>
+    class optional_array
+    {
+        static_assert(Size > 0u, "optional_array must not be empty");
+
+        using traits = tombstone_traits<T>;
+
+    public:
+        using value_type    = typename traits::object_type;
+        using is_compressed = std::integral_constant<bool, (traits::tombstone_count > 0u)>;
+
+        //=== constructors ===//
+        /// \effects Creates an array where all slots are empty.
+        optional_array() noexcept
+        {
+            for (auto i = 0u; i != Size; ++i)
+                impl_.store_none_flag(i);
+        }
+
+        /// \effects Destroys all values that are currently stored.
+        ~optional_array() noexcept
+        {
+            if (!std::is_trivially_destructible<value_type>::value)
+                for_each_present([&](std::size_t index, typename traits::reference) {
+                    traits::destroy_object(impl_.storage[index]);
+                });
+        }
+
+        optional_array(const optional_array&) = delete;
+        optional_array& operator=(const optional_array&) = delete;
+
+        //=== mutators ===//
+        /// \effects Creates a value in the specified slot by forwarding the arguments.
+        /// \requires `index < size()` and `has_value(index) == false`.
+        template <typename... Args>
+        void create_value(std::size_t index, Args&&... args)
+        {
+            DEBUG_ASSERT(!has_value(index), detail::precondition_handler{});
+            traits::create_object(impl_.storage[index], static_cast<Args&&>(args)...);
+            impl_.store_value_flag(index);
+        }
+
+        /// \effects Destroys the value currently stored in the specified slot.
+        /// \requires `index < size()` and `has_value(index) == true`.
+        void destroy_value(std::size_t index) noexcept
+        {
+            DEBUG_ASSERT(has_value(index), detail::precondition_handler{});
+            traits::destroy_object(impl_.storage[index]);
+            impl_.store_none_flag(index);
+        }
+
+        /// \effects Moves all values to the front of the array, keeping their relative order.
+        /// Afterwards the slots `[0, count)` contain a value, all others are empty.
+        /// \returns The number of values, i.e. `count`.
+        std::size_t compact()
+        {
+            using reference_type = typename std::remove_reference<typename traits::reference>::type;
+
+            auto count = std::size_t(0);
+            for_each_present([&](std::size_t index, typename traits::reference value) {
+                if (index != count)
+                {
+                    // count < index, so this slot has already been scanned
+                    traits::create_object(impl_.storage[count],
+                                          static_cast<reference_type&&>(value));
+                    impl_.store_value_flag(count);
+                    destroy_value(index);
+                }
+                ++count;
+            });
+            return count;
+        }
+
+        //=== accessors ===//
+        /// \returns The number of slots.
+        static constexpr std::size_t size() noexcept
+        {
+            return Size;
+        }
+
+        /// \returns Whether or not the specified slot currently stores a value.
+        /// \requires `index < size()`.
+        bool has_value(std::size_t index) const noexcept
+        {
+            DEBUG_ASSERT(index < Size, detail::precondition_handler{});
+            return impl_.has_value(index);
+        }
+
+        /// \returns A reference to the value currently stored in the specified slot.
+        /// \requires `index < size()` and `has_value(index) == true`.
+        /// \group value
+        auto value(std::size_t index) noexcept -> typename traits::reference
+        {
+            DEBUG_ASSERT(has_value(index), detail::precondition_handler{});
+            return traits::get_object(impl_.storage[index]);
+        }
+        /// \group value
+        auto value(std::size_t index) const noexcept -> typename traits::const_reference
+        {
+            DEBUG_ASSERT(has_value(index), detail::precondition_handler{});
+            return traits::get_object(impl_.storage[index]);
+        }
+
+        //=== bulk operations ===//
+        /// \returns The number of slots that currently store a value.
+        std::size_t count_present() const noexcept
+        {
+            auto result = std::size_t(0);
+            for (auto block = 0u; block != block_count(); ++block)
+                result += detail::popcount(impl_.presence_mask(block));
+            return result;
+        }
+
+        /// \effects Invokes `f(index, value(index))` for every slot that stores a value,
+        /// in increasing order of the index.
+        /// `f` may destroy the value of the current slot.
+        /// \group for_each_present
+        template <typename Func>
+        void for_each_present(Func&& f)
+        {
+            for (auto block = 0u; block != block_count(); ++block)
+                for (auto mask = impl_.presence_mask(block); mask != 0u; mask &= mask - 1u)
+                {
+                    auto index = block * opt_array_detail::block_size
+                                 + detail::count_trailing_zeros(mask);
+                    f(index, traits::get_object(impl_.storage[index]));
+                }
+        }
+        /// \group for_each_present
+        template <typename Func>
+        void for_each_present(Func&& f) const
+        {
+            for (auto block = 0u; block != block_count(); ++block)
+                for (auto mask = impl_.presence_mask(block); mask != 0u; mask &= mask - 1u)
+                {
+                    auto index = block * opt_array_detail::block_size
+                                 + detail::count_trailing_zeros(mask);
+                    f(index, traits::get_object(impl_.storage[index]));
+                }
+        }
+
+    private:
+        static constexpr std::size_t block_count() noexcept
+        {
+            return opt_array_detail::block_count(Size);
+        }
+
+        typename std::conditional<is_compressed::value,
+                                  opt_array_detail::compressed_optional_array<T, Size>,
+                                  opt_array_detail::uncompressed_optional_array<T, Size>>::type
+            impl_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_OPTIONAL_ARRAY_HPP_INCLUDED
@@ -9,6 +9,7 @@
 
 #include <foonathan/tiny/tiny_bool.hpp>
 #include <foonathan/tiny/tombstone.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
 
 namespace foonathan
 {
@@ -64,6 +65,102 @@ namespace tiny
             }
         };
 
+        // copies the stored value using the tombstone traits,
+        // unless the implementation can be copied trivially
+        template <typename T, class Impl,
+                  bool Trivial = std::is_trivially_copyable<Impl>::value
+                                 && std::is_copy_constructible<Impl>::value>
+        struct copyable_optional : Impl
+        {};
+
+        template <typename T, class Impl>
+        struct copyable_optional<T, Impl, false> : Impl
+        {
+            using traits         = tombstone_traits<T>;
+            using reference_type = typename std::remove_reference<typename traits::reference>::type;
+
+            copyable_optional() = default;
+
+            copyable_optional(const copyable_optional& other) : Impl()
+            {
+                if (other.has_value())
+                    create_value(traits::get_object(other.storage));
+                else
+                    this->store_none_flag();
+            }
+
+            copyable_optional(copyable_optional&& other) noexcept(
+                std::is_nothrow_move_constructible<typename traits::object_type>::value)
+            : Impl()
+            {
+                if (other.has_value())
+                    create_value(static_cast<reference_type&&>(traits::get_object(other.storage)));
+                else
+                    this->store_none_flag();
+            }
+
+            ~copyable_optional() noexcept = default;
+
+            copyable_optional& operator=(const copyable_optional& other)
+            {
+                if (this != &other)
+                {
+                    reset();
+                    if (other.has_value())
+                        create_value(traits::get_object(other.storage));
+                }
+                return *this;
+            }
+
+            copyable_optional& operator=(copyable_optional&& other) noexcept(
+                std::is_nothrow_move_constructible<typename traits::object_type>::value)
+            {
+                if (this != &other)
+                {
+                    reset();
+                    if (other.has_value())
+                        create_value(
+                            static_cast<reference_type&&>(traits::get_object(other.storage)));
+                }
+                return *this;
+            }
+
+        private:
+            template <typename Arg>
+            void create_value(Arg&& arg)
+            {
+                traits::create_object(this->storage, static_cast<Arg&&>(arg));
+                this->store_value_flag();
+            }
+
+            void reset() noexcept
+            {
+                if (this->has_value())
+                {
+                    traits::destroy_object(this->storage);
+                    this->store_none_flag();
+                }
+            }
+        };
+
+        // deletes the copy operations if the value cannot be copied,
+        // copyable_optional has to declare them unconditionally
+        // (depends on T, so nested optionals don't share the empty base)
+        template <typename T, bool Copyable>
+        struct copy_control
+        {};
+
+        template <typename T>
+        struct copy_control<T, false>
+        {
+            copy_control() noexcept                          = default;
+            copy_control(const copy_control&)                = delete;
+            copy_control(copy_control&&) noexcept            = default;
+            ~copy_control() noexcept                         = default;
+            copy_control& operator=(const copy_control&)     = delete;
+            copy_control& operator=(copy_control&&) noexcept = default;
+        };
+
         template <typename T>
         struct compressed_traits;
         template <typename T>
@@ -76,6 +173,8 @@ namespace tiny
     /// A proper optional type should be built on top of it.
     template <typename T>
     class optional_impl
+    : opt_detail::copy_control<
+          T, std::is_copy_constructible<typename tombstone_traits<T>::object_type>::value>
     {
         using traits = tombstone_traits<T>;
 
@@ -90,12 +189,29 @@ namespace tiny
             impl_.store_none_flag();
         }
 
+        /// \effects Creates an optional containing a copy of the value stored in `other`,
+        /// if there is one.
+        /// \notes The copy and move constructors are trivial if the storage of `T` is trivially
+        /// copyable.
+        /// The copy constructor is deleted if `T` is not copy constructible.
+        /// \group copy_ctor
+        optional_impl(const optional_impl& other) = default;
+        /// \group copy_ctor
+        optional_impl(optional_impl&& other) = default;
+
         /// \effects Does nothing.
         /// \notes This will leak the value if there is one stored currently.
         ~optional_impl() noexcept = default;
 
-        optional_impl(const optional_impl&) = delete;
-        optional_impl& operator=(const optional_impl&) = delete;
+        /// \effects Destroys the value currently stored, if there is one,
+        /// and then copies the value stored in `other`, if there is one.
+        /// \notes The copy and move assignment operators are trivial if the storage of `T` is
+        /// trivially copyable.
+        /// The copy assignment operator is deleted if `T` is not copy constructible.
+        /// \group copy_assign
+        optional_impl& operator=(const optional_impl& other) = default;
+        /// \group copy_assign
+        optional_impl& operator=(optional_impl&& other) = default;
 
         //=== mutators ===//
         /// \effects Creates a value by forwarding the arguments.
@@ -140,8 +256,10 @@ namespace tiny
         }
 
     private:
-        typename std::conditional<is_compressed::value, opt_detail::compressed_optional<T>,
-                                  opt_detail::uncompressed_optional<T>>::type impl_;
+        opt_detail::copyable_optional<
+            T, typename std::conditional<is_compressed::value, opt_detail::compressed_optional<T>,
+                                         opt_detail::uncompressed_optional<T>>::type>
+            impl_;
 
         friend opt_detail::compressed_traits<T>;
         friend opt_detail::uncompressed_traits<T>;
@@ -165,11 +283,13 @@ namespace tiny
                 tombstone_traits<T>::create_tombstone(storage.impl_.storage, tombstone_index);
             }
 
-            // optional_impl only has a default constructor
-            static void create_object(storage_type& storage)
+            // default constructor creates an empty optional,
+            // copy/move constructor copies the representation of a valid object
+            // either way this overrides the tombstone so it means no tombstone at this level
+            template <typename... Args>
+            static void create_object(storage_type& storage, Args&&... args)
             {
-                // this overrides the tombstone so it means no tombstone at this level
-                storage.impl_.store_none_flag();
+                ::new (static_cast<void*>(&storage)) storage_type(static_cast<Args&&>(args)...);
             }
 
             static void destroy_object(storage_type&) noexcept {}
@@ -208,12 +328,13 @@ namespace tiny
                 storage.impl_.flag.spare_bits().put(tombstone_index + 1);
             }
 
-            // optional_impl only has a default constructor
-            static void create_object(storage_type& storage)
+            // default constructor creates an empty optional with cleared spare bits,
+            // copy/move constructor copies the spare bits of a valid object, which are cleared
+            // either way this overrides the tombstone so it means no tombstone at this level
+            template <typename... Args>
+            static void create_object(storage_type& storage, Args&&... args)
             {
-                // this overrides the tombstone so it means no tombstone at this level
-                storage.impl_.store_none_flag();
-                storage.impl_.flag.spare_bits().put(0);
+                ::new (static_cast<void*>(&storage)) storage_type(static_cast<Args&&>(args)...);
             }
 
             static void destroy_object(storage_type&) noexcept {}
@@ -234,6 +355,14 @@ namespace tiny
         };
     } // namespace opt_detail
 
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::optional_impl]().
+    ///
+    /// It is trivially relocatable if the storage of `T` is.
+    template <typename T>
+    struct is_trivially_relocatable<optional_impl<T>>
+    : is_trivially_relocatable<typename tombstone_traits<T>::storage_type>
+    {};
+
     /// Specialization of the tombstone traits for [tiny::optional_impl]().
     template <typename T>
     struct tombstone_traits<optional_impl<T>>
@@ -9,6 +9,7 @@
 
 #include <foonathan/tiny/padding_traits.hpp>
 #include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
 
 namespace foonathan
 {
@@ -301,6 +302,14 @@ namespace tiny
             (void)for_each;
         }
     };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::padding_tiny_storage]().
+    ///
+    /// It is trivially relocatable if the padded type is.
+    template <class Padded, class... TinyTypes>
+    struct is_trivially_relocatable<padding_tiny_storage<Padded, TinyTypes...>>
+    : is_trivially_relocatable<Padded>
+    {};
 } // namespace tiny
 } // namespace foonathan
 
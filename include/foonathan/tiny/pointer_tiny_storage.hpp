@@ -7,6 +7,7 @@
 
 #include <foonathan/tiny/detail/ilog2.hpp>
 #include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
 
 namespace foonathan
 {
@@ -98,13 +99,12 @@ namespace tiny
             }
         };
 
-        template <typename T, std::size_t Alignment, class... TinyTypes>
+        // Policy must provide set_pointer() and get_pointer()
+        template <typename T, class Policy>
         class pointer_proxy
         {
         public:
-            pointer_proxy(int, pointer_storage_policy<Alignment, TinyTypes...>* storage) noexcept
-            : storage_(storage)
-            {}
+            pointer_proxy(int, Policy* storage) noexcept : storage_(storage) {}
 
             operator T*() const noexcept
             {
@@ -150,7 +150,7 @@ namespace tiny
             }
 
         private:
-            pointer_storage_policy<Alignment, TinyTypes...>* storage_;
+            Policy* storage_;
         };
     } // namespace detail
 
@@ -235,16 +235,25 @@ namespace tiny
         }
 
         /// \returns A proxy that behaves like a mutable reference to the stored pointer.
-        detail::pointer_proxy<value_type, alignment_of<T>(), TinyTypes...> pointer() noexcept
+        detail::pointer_proxy<value_type,
+                              detail::pointer_storage_policy<alignment_of<T>(), TinyTypes...>>
+            pointer() noexcept
         {
             return {0, &this->storage_policy()};
         }
         /// \returns The stored pointer.
-        T* pointer() const noexcept
+        pointer_type pointer() const noexcept
         {
-            return this->storage_policy().template get_pointer<T>();
+            return this->storage_policy().template get_pointer<value_type>();
         }
     };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::pointer_tiny_storage]().
+    ///
+    /// It only stores the pointer and bits, so it is always trivially relocatable.
+    template <typename T, class... TinyTypes>
+    struct is_trivially_relocatable<pointer_tiny_storage<T, TinyTypes...>> : std::true_type
+    {};
 } // namespace tiny
 } // namespace foonathan
 
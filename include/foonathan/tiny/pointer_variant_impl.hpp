@@ -7,6 +7,7 @@
 
 #include <foonathan/tiny/pointer_tiny_storage.hpp>
 #include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tombstone.hpp>
 
 namespace foonathan
 {
@@ -76,6 +77,31 @@ namespace tiny
         {
             using is_valid = typename get_pointer_tag<T, Tail...>::is_valid;
         };
+
+        //=== visit ===//
+        template <class Visitor>
+        using pointer_visit_result = decltype(std::declval<Visitor>()(nullptr));
+
+        template <class Visitor, typename... Ts>
+        class pointer_visit_table
+        {
+            using result   = pointer_visit_result<Visitor>;
+            using function = result (*)(Visitor&&, const void*);
+
+            template <typename T>
+            static result invoke(Visitor&& visitor, const void* ptr)
+            {
+                // C style cast because we might need to cast away const-ness
+                return static_cast<Visitor&&>(visitor)((typename alignment_traits<T>::type*)(ptr));
+            }
+
+        public:
+            static const function* get() noexcept
+            {
+                static constexpr function table[] = {&invoke<Ts>...};
+                return table;
+            }
+        };
     } // namespace detail
 
     /// The storage implementation of a variant of pointer to one of the types that uses spare bits
@@ -123,7 +149,8 @@ namespace tiny
         /// \effects Resets the variant to `nullptr`.
         void reset(std::nullptr_t) noexcept
         {
-            storage_.pointer() = nullptr;
+            // clear all bits, so a null pointer has a single representation
+            storage_ = storage_type();
         }
 
         /// \effects Resets the variant to a pointer to the given object.
@@ -133,8 +160,13 @@ namespace tiny
         {
             static_assert(typename tag_of<T>::is_valid{}, "type cannot be stored in variant");
 
-            storage_.pointer() = ptr;
-            storage_.tiny()    = tag_of<T>::value;
+            if (ptr == nullptr)
+                reset(nullptr);
+            else
+            {
+                storage_.pointer() = ptr;
+                storage_.tiny()    = tag_of<T>::value;
+            }
         }
 
         //=== accessors ===//
@@ -173,8 +205,99 @@ namespace tiny
             return (T*)(get());
         }
 
+        //=== visit ===//
+        /// \effects Invokes `visitor(nullptr)` if the variant does not point to an object.
+        /// Otherwise invokes `visitor(pointer_to<T>())`, where `T` is the currently active element
+        /// type. It extracts the tag once and then dispatches through a table of function pointers.
+        /// \returns The result of the invocation.
+        /// \requires The visitor returns the same type for all invocations.
+        template <class Visitor>
+        auto visit(Visitor&& visitor) const -> detail::pointer_visit_result<Visitor>
+        {
+            auto ptr = get();
+            if (ptr == nullptr)
+                return static_cast<Visitor&&>(visitor)(nullptr);
+
+            std::size_t tag = storage_.tiny();
+            DEBUG_ASSERT(tag < sizeof...(Ts), detail::assert_handler{});
+            return detail::pointer_visit_table<Visitor, Ts...>::get()[tag](
+                static_cast<Visitor&&>(visitor), ptr);
+        }
+
     private:
+        static constexpr std::size_t tag_bits = detail::pointer_variant_tag<Ts...>::bit_size();
+        static constexpr std::size_t null_bits
+            = tag_bits + decltype(std::declval<const storage_type&>().spare_bits())::size();
+
+        // a null pointer uses no bits,
+        // so a null pointer with the remaining bits set can be used as tombstone
+        void set_null_bits(std::uintmax_t bits) noexcept
+        {
+            storage_.pointer() = nullptr;
+            storage_.tiny()    = bits & detail::all_bits_set(tag_bits);
+            storage_.spare_bits().put(bits >> tag_bits);
+        }
+        std::uintmax_t get_null_bits() const noexcept
+        {
+            auto spare = storage_.spare_bits().extract();
+            return (spare << tag_bits) | std::uintmax_t(storage_.tiny());
+        }
+
         storage_type storage_;
+
+        friend tombstone_traits<pointer_variant_impl>;
+    };
+
+    /// Specialization of the tombstone traits for [tiny::pointer_variant_impl]().
+    ///
+    /// A tombstone is a null pointer where the bits of the tag and the remaining alignment bits
+    /// store the index plus one.
+    template <typename... Ts>
+    struct tombstone_traits<pointer_variant_impl<Ts...>>
+    {
+    private:
+        using variant = pointer_variant_impl<Ts...>;
+
+    public:
+        using object_type     = variant;
+        using storage_type    = tombstone_detail::storage_type_for<variant>;
+        using reference       = variant&;
+        using const_reference = const variant&;
+
+        static constexpr std::size_t tombstone_count
+            = tombstone_detail::clamp_tombstone_count(detail::all_bits_set(variant::null_bits));
+
+        static void create_tombstone(storage_type& storage, std::size_t tombstone_index) noexcept
+        {
+            ::new (static_cast<void*>(&storage.object)) variant(nullptr);
+            storage.object.set_null_bits(tombstone_index + 1u);
+        }
+
+        template <typename... Args>
+        static void create_object(storage_type& storage, Args&&... args)
+        {
+            ::new (static_cast<void*>(&storage.object)) variant(static_cast<Args&&>(args)...);
+        }
+
+        static void destroy_object(storage_type&) noexcept {}
+
+        static std::size_t get_tombstone(const storage_type& storage) noexcept
+        {
+            if (storage.object.has_value())
+                return std::size_t(-1);
+            else
+                // an actual null pointer has no bits set, so it overflows
+                return std::size_t(storage.object.get_null_bits() - 1u);
+        }
+
+        static reference get_object(storage_type& storage) noexcept
+        {
+            return storage.object;
+        }
+        static const_reference get_object(const storage_type& storage) noexcept
+        {
+            return storage.object;
+        }
     };
 } // namespace tiny
 } // namespace foonathan
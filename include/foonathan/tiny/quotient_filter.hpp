@@ -0,0 +1,465 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_QUOTIENT_FILTER_HPP_INCLUDED
+#define FOONATHAN_TINY_QUOTIENT_FILTER_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/detail/bit_count.hpp>
+#include <foonathan/tiny/detail/hash.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace qf_detail
+    {
+        constexpr std::size_t word_bits = 64u;
+
+        constexpr std::size_t word_count(std::size_t bits) noexcept
+        {
+            return (bits + word_bits - 1u) / word_bits;
+        }
+
+        constexpr std::uint64_t low_mask(std::size_t bits) noexcept
+        {
+            return bits == word_bits ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1u;
+        }
+
+        inline bool get_bit(const std::uint64_t* words, std::size_t i) noexcept
+        {
+            return ((words[i / word_bits] >> (i % word_bits)) & 1u) != 0u;
+        }
+
+        inline void set_bit(std::uint64_t* words, std::size_t i, bool value) noexcept
+        {
+            auto mask = std::uint64_t(1) << (i % word_bits);
+            if (value)
+                words[i / word_bits] |= mask;
+            else
+                words[i / word_bits] &= ~mask;
+        }
+
+        // index of the first set bit at or after i of the words returned by word(index),
+        // wraps around at the end
+        template <class WordFn>
+        std::size_t find_next(std::size_t count, std::size_t i, WordFn word) noexcept
+        {
+            auto index = i / word_bits;
+            auto bits  = word(index) & (~std::uint64_t(0) << (i % word_bits));
+            // one more than count, to look at the lower bits of the first word again
+            for (auto n = std::size_t(0); n != count + 1u; ++n)
+            {
+                if (bits != 0u)
+                    return index * word_bits + detail::count_trailing_zeros(bits);
+                index = index + 1u == count ? 0u : index + 1u;
+                bits  = word(index);
+            }
+            DEBUG_UNREACHABLE(detail::assert_handler{});
+            return i;
+        }
+
+        // index of the first set bit at or before i of the words returned by word(index),
+        // wraps around at the beginning
+        template <class WordFn>
+        std::size_t find_prev(std::size_t count, std::size_t i, WordFn word) noexcept
+        {
+            auto index = i / word_bits;
+            auto bits  = word(index) & (~std::uint64_t(0) >> (word_bits - 1u - i % word_bits));
+            for (auto n = std::size_t(0); n != count + 1u; ++n)
+            {
+                if (bits != 0u)
+                    return index * word_bits + word_bits - 1u - detail::count_leading_zeros(bits);
+                index = index == 0u ? count - 1u : index - 1u;
+                bits  = word(index);
+            }
+            DEBUG_UNREACHABLE(detail::assert_handler{});
+            return i;
+        }
+    } // namespace qf_detail
+
+    /// A quotient filter, an approximate membership query structure that supports deletion.
+    ///
+    /// An element is identified by its hash, which is mixed and reduced to a fingerprint of
+    /// `QuotientBits + RemainderBits` bits.
+    /// The quotient selects one of the `2^QuotientBits` slots and the remainder is stored,
+    /// in sorted runs of remainders with the same quotient.
+    /// Lookups have no false negatives and a false positive rate of about
+    /// `load factor * 2^-RemainderBits`.
+    ///
+    /// Each slot consists of three metadata bits (occupied, continuation and shifted) and the
+    /// remainder, which are stored bit-densely: the metadata bits in three bitsets,
+    /// so cluster scans can process 64 slots at once, and the remainders in a packed array.
+    /// Like [tiny::optional_array]() it does not allocate memory.
+    ///
+    /// Inserting the same element twice stores it twice, erasing it removes one copy.
+    /// Filters with the same fingerprint size can be merged and converted into each other.
+    /// \requires `QuotientBits` must be at least 6 and the fingerprint size must be at most 64.
+    template <std::size_t QuotientBits, std::size_t RemainderBits>
+    class quotient_filter
+    {
+        static_assert(QuotientBits >= 6u, "filter must have at least 64 slots");
+        static_assert(RemainderBits >= 1u && QuotientBits + RemainderBits <= 64u,
+                      "invalid fingerprint size");
+
+        static constexpr std::size_t slot_count = std::size_t(1) << QuotientBits;
+        static constexpr std::size_t metadata_words = slot_count / qf_detail::word_bits;
+        static constexpr std::size_t remainder_words
+            = qf_detail::word_count(slot_count * RemainderBits);
+
+    public:
+        using fingerprint_type = std::uint64_t;
+
+        //=== constructors ===//
+        /// \effects Creates an empty filter.
+        quotient_filter() noexcept
+        : occupied_{}, continuation_{}, shifted_{}, remainders_{}, size_(0u)
+        {}
+
+        /// \effects Creates a filter containing the elements of the other filter,
+        /// i.e. resizes a filter.
+        /// \requires The fingerprints must have the same size, and all elements must fit.
+        template <std::size_t OtherQuotientBits, std::size_t OtherRemainderBits>
+        explicit quotient_filter(
+            const quotient_filter<OtherQuotientBits, OtherRemainderBits>& other) noexcept
+        : quotient_filter()
+        {
+            auto result = merge(other);
+            DEBUG_ASSERT(result, detail::precondition_handler{}, "filter too small");
+            (void)result;
+        }
+
+        //=== modifiers ===//
+        /// \effects Inserts the element with the given hash.
+        /// \returns `true` if it was inserted, `false` if the filter is full.
+        bool insert(std::size_t hash) noexcept
+        {
+            return insert_fingerprint(fingerprint(hash));
+        }
+
+        /// \effects Inserts an element with the given fingerprint.
+        /// \returns `true` if it was inserted, `false` if the filter is full.
+        /// \requires `fingerprint < 2^fingerprint_bits()`.
+        bool insert_fingerprint(fingerprint_type fingerprint) noexcept
+        {
+            DEBUG_ASSERT(fingerprint <= qf_detail::low_mask(fingerprint_bits()),
+                         detail::precondition_handler{}, "invalid fingerprint");
+            if (size_ == slot_count)
+                return false;
+
+            auto quotient  = std::size_t(fingerprint >> RemainderBits);
+            auto remainder = fingerprint & qf_detail::low_mask(RemainderBits);
+
+            auto was_occupied = is_occupied(quotient);
+            if (is_empty(quotient))
+            {
+                // the simple case: the canonical slot is free
+                qf_detail::set_bit(occupied_, quotient, true);
+                set_remainder(quotient, remainder);
+                ++size_;
+                return true;
+            }
+            qf_detail::set_bit(occupied_, quotient, true);
+
+            auto start           = run_start(quotient);
+            auto slot            = start;
+            auto is_continuation = false;
+            if (was_occupied)
+            {
+                // find the position in the sorted run
+                do
+                {
+                    if (get_remainder(slot) > remainder)
+                        break;
+                    slot = next(slot);
+                } while (qf_detail::get_bit(continuation_, slot));
+
+                if (slot == start)
+                    // the old head of the run is going to be a continuation
+                    qf_detail::set_bit(continuation_, start, true);
+                else
+                    is_continuation = true;
+            }
+
+            shift_right(slot);
+            set_remainder(slot, remainder);
+            qf_detail::set_bit(continuation_, slot, is_continuation);
+            qf_detail::set_bit(shifted_, slot, slot != quotient);
+            ++size_;
+            return true;
+        }
+
+        /// \effects Removes one copy of the element with the given hash.
+        /// \returns `true` if it was removed, `false` if it wasn't in the filter.
+        /// \notes Erasing elements that have not been inserted can remove a different element
+        /// with the same fingerprint.
+        bool erase(std::size_t hash) noexcept
+        {
+            return erase_fingerprint(fingerprint(hash));
+        }
+
+        /// \effects Removes one copy of an element with the given fingerprint.
+        /// \returns `true` if it was removed, `false` if it wasn't in the filter.
+        /// \requires `fingerprint < 2^fingerprint_bits()`.
+        bool erase_fingerprint(fingerprint_type fingerprint) noexcept
+        {
+            DEBUG_ASSERT(fingerprint <= qf_detail::low_mask(fingerprint_bits()),
+                         detail::precondition_handler{}, "invalid fingerprint");
+            auto quotient  = std::size_t(fingerprint >> RemainderBits);
+            auto remainder = fingerprint & qf_detail::low_mask(RemainderBits);
+
+            std::size_t start, slot;
+            if (!find(quotient, remainder, start, slot))
+                return false;
+
+            if (slot == start && !qf_detail::get_bit(continuation_, next(slot)))
+                // removing the only element of the run
+                qf_detail::set_bit(occupied_, quotient, false);
+
+            // move the rest of the cluster one slot to the left
+            for (auto cur = slot;; cur = next(cur))
+            {
+                auto from = next(cur);
+                if (is_empty(from) || !qf_detail::get_bit(shifted_, from))
+                {
+                    set_remainder(cur, 0u);
+                    qf_detail::set_bit(continuation_, cur, false);
+                    qf_detail::set_bit(shifted_, cur, false);
+                    break;
+                }
+
+                auto from_continuation = qf_detail::get_bit(continuation_, from);
+                if (!from_continuation)
+                    // start of the next run
+                    quotient = next_occupied(next(quotient));
+                // if the head was removed, the next element is the new head
+                auto is_continuation = from_continuation && !(cur == slot && slot == start);
+
+                set_remainder(cur, get_remainder(from));
+                qf_detail::set_bit(continuation_, cur, is_continuation);
+                qf_detail::set_bit(shifted_, cur, is_continuation || cur != quotient);
+            }
+
+            --size_;
+            return true;
+        }
+
+        /// \effects Inserts all elements of the other filter.
+        /// \returns `true` if all elements were inserted, `false` if the filter became full.
+        /// \requires The fingerprints must have the same size.
+        template <std::size_t OtherQuotientBits, std::size_t OtherRemainderBits>
+        bool merge(const quotient_filter<OtherQuotientBits, OtherRemainderBits>& other) noexcept
+        {
+            static_assert(OtherQuotientBits + OtherRemainderBits == QuotientBits + RemainderBits,
+                          "fingerprint size must be the same");
+            auto result = true;
+            other.for_each_fingerprint([&](fingerprint_type fingerprint) {
+                if (!insert_fingerprint(fingerprint))
+                    result = false;
+            });
+            return result;
+        }
+
+        /// \effects Removes all elements.
+        void clear() noexcept
+        {
+            for (auto index = std::size_t(0); index != metadata_words; ++index)
+                occupied_[index] = continuation_[index] = shifted_[index] = 0u;
+            for (auto& word : remainders_)
+                word = 0u;
+            size_ = 0u;
+        }
+
+        //=== lookup ===//
+        /// \returns Whether or not the element with the given hash might be in the filter.
+        /// If it returns `false`, the element is definitely not in the filter.
+        bool contains(std::size_t hash) const noexcept
+        {
+            auto fp = fingerprint(hash);
+
+            std::size_t start, slot;
+            return find(std::size_t(fp >> RemainderBits), fp & qf_detail::low_mask(RemainderBits),
+                        start, slot);
+        }
+
+        /// \effects Invokes `f` with the fingerprint of every element.
+        template <typename Func>
+        void for_each_fingerprint(Func f) const
+        {
+            // cluster starts are in their canonical slot
+            for (auto index = std::size_t(0); index != metadata_words; ++index)
+                for (auto starts = occupied_[index] & ~shifted_[index]; starts != 0u;
+                     starts &= starts - 1u)
+                {
+                    auto quotient = index * qf_detail::word_bits
+                                    + detail::count_trailing_zeros(starts);
+                    for (auto slot = quotient;;)
+                    {
+                        f((fingerprint_type(quotient) << RemainderBits) | get_remainder(slot));
+
+                        slot = next(slot);
+                        if (is_empty(slot) || !qf_detail::get_bit(shifted_, slot))
+                            break;
+                        else if (!qf_detail::get_bit(continuation_, slot))
+                            quotient = next_occupied(next(quotient));
+                    }
+                }
+        }
+
+        //=== accessors ===//
+        /// \returns The number of elements.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+        /// \returns Whether or not there are no elements.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns The number of slots, which is the maximal number of elements.
+        static constexpr std::size_t capacity() noexcept
+        {
+            return slot_count;
+        }
+
+        /// \returns The number of bits of a fingerprint.
+        static constexpr std::size_t fingerprint_bits() noexcept
+        {
+            return QuotientBits + RemainderBits;
+        }
+
+        /// \returns The fingerprint of the given hash.
+        static fingerprint_type fingerprint(std::size_t hash) noexcept
+        {
+            return detail::mix_hash(hash) & qf_detail::low_mask(fingerprint_bits());
+        }
+
+    private:
+        static std::size_t next(std::size_t slot) noexcept
+        {
+            return (slot + 1u) & (slot_count - 1u);
+        }
+
+        //=== metadata ===//
+        bool is_occupied(std::size_t slot) const noexcept
+        {
+            return qf_detail::get_bit(occupied_, slot);
+        }
+
+        bool is_empty(std::size_t slot) const noexcept
+        {
+            auto index = slot / qf_detail::word_bits;
+            auto bits  = occupied_[index] | continuation_[index] | shifted_[index];
+            return ((bits >> (slot % qf_detail::word_bits)) & 1u) == 0u;
+        }
+
+        std::size_t next_occupied(std::size_t slot) const noexcept
+        {
+            return qf_detail::find_next(metadata_words, slot,
+                                        [&](std::size_t index) { return occupied_[index]; });
+        }
+
+        // index of the first slot of the run with the given quotient,
+        // or where it would be if there is none
+        std::size_t run_start(std::size_t quotient) const noexcept
+        {
+            // walk back to the start of the cluster, which is in its canonical slot
+            auto canonical = qf_detail::find_prev(metadata_words, quotient, [&](std::size_t index) {
+                return ~shifted_[index];
+            });
+
+            // then skip one run for every occupied slot until the quotient
+            auto slot = canonical;
+            while (canonical != quotient)
+            {
+                slot = qf_detail::find_next(metadata_words, next(slot), [&](std::size_t index) {
+                    return ~continuation_[index];
+                });
+                canonical = next_occupied(next(canonical));
+            }
+            return slot;
+        }
+
+        bool find(std::size_t quotient, fingerprint_type remainder, std::size_t& start,
+                  std::size_t& slot) const noexcept
+        {
+            if (!is_occupied(quotient))
+                return false;
+
+            start = slot = run_start(quotient);
+            do
+            {
+                auto cur = get_remainder(slot);
+                if (cur == remainder)
+                    return true;
+                else if (cur > remainder)
+                    // run is sorted
+                    return false;
+                slot = next(slot);
+            } while (qf_detail::get_bit(continuation_, slot));
+            return false;
+        }
+
+        // moves the elements in [slot, first empty slot) one slot to the right
+        void shift_right(std::size_t slot) noexcept
+        {
+            auto empty = qf_detail::find_next(metadata_words, slot, [&](std::size_t index) {
+                return ~(occupied_[index] | continuation_[index] | shifted_[index]);
+            });
+            for (auto cur = empty; cur != slot;)
+            {
+                auto prev = cur == 0u ? slot_count - 1u : cur - 1u;
+                set_remainder(cur, get_remainder(prev));
+                qf_detail::set_bit(continuation_, cur, qf_detail::get_bit(continuation_, prev));
+                qf_detail::set_bit(shifted_, cur, true);
+                cur = prev;
+            }
+        }
+
+        //=== remainders ===//
+        fingerprint_type get_remainder(std::size_t slot) const noexcept
+        {
+            auto bit    = slot * RemainderBits;
+            auto index  = bit / qf_detail::word_bits;
+            auto offset = bit % qf_detail::word_bits;
+
+            auto result = remainders_[index] >> offset;
+            if (offset + RemainderBits > qf_detail::word_bits)
+                result |= remainders_[index + 1u] << (qf_detail::word_bits - offset);
+            return result & qf_detail::low_mask(RemainderBits);
+        }
+
+        void set_remainder(std::size_t slot, fingerprint_type remainder) noexcept
+        {
+            auto bit    = slot * RemainderBits;
+            auto index  = bit / qf_detail::word_bits;
+            auto offset = bit % qf_detail::word_bits;
+            auto mask   = qf_detail::low_mask(RemainderBits);
+
+            remainders_[index] = (remainders_[index] & ~(mask << offset)) | (remainder << offset);
+            if (offset + RemainderBits > qf_detail::word_bits)
+            {
+                auto shift = qf_detail::word_bits - offset;
+                remainders_[index + 1u]
+                    = (remainders_[index + 1u] & ~(mask >> shift)) | (remainder >> shift);
+            }
+        }
+
+        std::uint64_t occupied_[metadata_words];
+        std::uint64_t continuation_[metadata_words];
+        std::uint64_t shifted_[metadata_words];
+        std::uint64_t remainders_[remainder_words];
+        std::size_t   size_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_QUOTIENT_FILTER_HPP_INCLUDED
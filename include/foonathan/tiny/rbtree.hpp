@@ -0,0 +1,831 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_RBTREE_HPP_INCLUDED
+#define FOONATHAN_TINY_RBTREE_HPP_INCLUDED
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include <foonathan/tiny/pointer_tiny_storage.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <typename T, class Compare>
+    class rbtree;
+
+    /// \exclude
+    namespace rbtree_detail
+    {
+        struct access;
+    } // namespace rbtree_detail
+
+    /// The hook of an element of an [tiny::rbtree]().
+    ///
+    /// An element type must publicly inherit from it.
+    /// It consists of three pointers, the color of the node is stored in the alignment bit
+    /// of the parent pointer using a [tiny::pointer_tiny_storage]().
+    class rbtree_hook
+    {
+    public:
+        /// \effects Creates a hook that is not linked into a tree.
+        rbtree_hook() noexcept : left_(nullptr), right_(nullptr) {}
+
+        /// \effects Creates a hook that is not linked into a tree,
+        /// copying an element does not copy its position in the tree.
+        rbtree_hook(const rbtree_hook&) noexcept : rbtree_hook() {}
+
+        /// \effects Does nothing,
+        /// assigning an element does not change its position in the tree.
+        rbtree_hook& operator=(const rbtree_hook&) noexcept
+        {
+            return *this;
+        }
+
+        /// \returns Whether or not the element is currently linked into a tree.
+        bool is_linked() const noexcept
+        {
+            return parent_.pointer() != nullptr;
+        }
+
+    private:
+        // the type is incomplete here, so the alignment has to be specified
+        pointer_tiny_storage<aligned_obj<rbtree_hook, alignof(void*)>, tiny_bool> parent_;
+        rbtree_hook*                                                              left_;
+        rbtree_hook*                                                              right_;
+
+        friend rbtree_detail::access;
+    };
+
+    /// \exclude
+    namespace rbtree_detail
+    {
+        using node = rbtree_hook;
+
+        struct access
+        {
+            static node* parent(const node* n) noexcept
+            {
+                return n->parent_.pointer();
+            }
+            static void set_parent(node* n, node* parent) noexcept
+            {
+                n->parent_.pointer() = parent;
+            }
+
+            static bool is_red(const node* n) noexcept
+            {
+                return n->parent_.tiny();
+            }
+            static void set_red(node* n, bool red) noexcept
+            {
+                n->parent_.tiny() = red;
+            }
+
+            static node*& left(node* n) noexcept
+            {
+                return n->left_;
+            }
+            static node* left(const node* n) noexcept
+            {
+                return n->left_;
+            }
+
+            static node*& right(node* n) noexcept
+            {
+                return n->right_;
+            }
+            static node* right(const node* n) noexcept
+            {
+                return n->right_;
+            }
+
+            static void unlink(node* n) noexcept
+            {
+                n->parent_ = decltype(n->parent_)();
+                n->left_   = nullptr;
+                n->right_  = nullptr;
+            }
+        };
+
+        inline bool is_black(const node* n) noexcept
+        {
+            return n == nullptr || !access::is_red(n);
+        }
+
+        inline node* minimum(node* n) noexcept
+        {
+            while (access::left(n))
+                n = access::left(n);
+            return n;
+        }
+
+        inline node* maximum(node* n) noexcept
+        {
+            while (access::right(n))
+                n = access::right(n);
+            return n;
+        }
+
+        // The tree has a header node: its parent is the root, its left child the minimum,
+        // and its right child the maximum. It is red, which distinguishes it from the root.
+        inline void init_header(node* header) noexcept
+        {
+            access::set_parent(header, nullptr);
+            access::set_red(header, true);
+            access::left(header)  = header;
+            access::right(header) = header;
+        }
+
+        inline node* increment(node* n) noexcept
+        {
+            if (access::right(n))
+                return minimum(access::right(n));
+
+            auto parent = access::parent(n);
+            while (n == access::right(parent))
+            {
+                n      = parent;
+                parent = access::parent(parent);
+            }
+            // if the root is the maximum, we've reached the header from above
+            return access::right(n) != parent ? parent : n;
+        }
+
+        inline node* decrement(node* n) noexcept
+        {
+            if (access::is_red(n) && access::parent(access::parent(n)) == n)
+                // the header, so decrement to the maximum
+                return access::right(n);
+            else if (access::left(n))
+                return maximum(access::left(n));
+
+            auto parent = access::parent(n);
+            while (n == access::left(parent))
+            {
+                n      = parent;
+                parent = access::parent(parent);
+            }
+            return parent;
+        }
+
+        // replaces the child of the parent, which can be the header
+        inline void replace_child(node* header, node* parent, node* old_child,
+                                  node* new_child) noexcept
+        {
+            if (parent == header)
+                access::set_parent(header, new_child);
+            else if (access::left(parent) == old_child)
+                access::left(parent) = new_child;
+            else
+                access::right(parent) = new_child;
+        }
+
+        inline void rotate_left(node* header, node* n) noexcept
+        {
+            auto child       = access::right(n);
+            access::right(n) = access::left(child);
+            if (access::left(child))
+                access::set_parent(access::left(child), n);
+
+            access::set_parent(child, access::parent(n));
+            replace_child(header, access::parent(n), n, child);
+
+            access::left(child) = n;
+            access::set_parent(n, child);
+        }
+
+        inline void rotate_right(node* header, node* n) noexcept
+        {
+            auto child      = access::left(n);
+            access::left(n) = access::right(child);
+            if (access::right(child))
+                access::set_parent(access::right(child), n);
+
+            access::set_parent(child, access::parent(n));
+            replace_child(header, access::parent(n), n, child);
+
+            access::right(child) = n;
+            access::set_parent(n, child);
+        }
+
+        // links n as the left or right child of parent and restores the invariants
+        inline void insert_and_rebalance(node* header, node* parent, bool insert_left,
+                                         node* n) noexcept
+        {
+            access::set_parent(n, parent);
+            access::left(n)  = nullptr;
+            access::right(n) = nullptr;
+            access::set_red(n, true);
+
+            if (insert_left)
+            {
+                access::left(parent) = n;
+                if (parent == header)
+                {
+                    access::set_parent(header, n);
+                    access::right(header) = n;
+                }
+                else if (parent == access::left(header))
+                    access::left(header) = n;
+            }
+            else
+            {
+                access::right(parent) = n;
+                if (parent == access::right(header))
+                    access::right(header) = n;
+            }
+
+            while (n != access::parent(header) && access::is_red(access::parent(n)))
+            {
+                parent           = access::parent(n);
+                auto grandparent = access::parent(parent);
+                if (parent == access::left(grandparent))
+                {
+                    auto uncle = access::right(grandparent);
+                    if (!is_black(uncle))
+                    {
+                        access::set_red(parent, false);
+                        access::set_red(uncle, false);
+                        access::set_red(grandparent, true);
+                        n = grandparent;
+                    }
+                    else
+                    {
+                        if (n == access::right(parent))
+                        {
+                            n = parent;
+                            rotate_left(header, n);
+                        }
+                        access::set_red(access::parent(n), false);
+                        access::set_red(grandparent, true);
+                        rotate_right(header, grandparent);
+                    }
+                }
+                else
+                {
+                    auto uncle = access::left(grandparent);
+                    if (!is_black(uncle))
+                    {
+                        access::set_red(parent, false);
+                        access::set_red(uncle, false);
+                        access::set_red(grandparent, true);
+                        n = grandparent;
+                    }
+                    else
+                    {
+                        if (n == access::left(parent))
+                        {
+                            n = parent;
+                            rotate_right(header, n);
+                        }
+                        access::set_red(access::parent(n), false);
+                        access::set_red(grandparent, true);
+                        rotate_left(header, grandparent);
+                    }
+                }
+            }
+            access::set_red(access::parent(header), false);
+        }
+
+        // unlinks n and restores the invariants
+        inline void erase_and_rebalance(node* header, node* n) noexcept
+        {
+            // successor is the node that is actually removed from its position,
+            // child replaces it
+            auto    successor = n;
+            node*   child     = nullptr;
+            node*   child_parent = nullptr;
+            if (access::left(successor) == nullptr)
+                child = access::right(successor);
+            else if (access::right(successor) == nullptr)
+                child = access::left(successor);
+            else
+            {
+                successor = minimum(access::right(successor));
+                child     = access::right(successor);
+            }
+
+            bool removed_red;
+            if (successor != n)
+            {
+                // move successor into the position of n
+                access::set_parent(access::left(n), successor);
+                access::left(successor) = access::left(n);
+                if (successor != access::right(n))
+                {
+                    child_parent = access::parent(successor);
+                    if (child)
+                        access::set_parent(child, child_parent);
+                    access::left(child_parent) = child;
+
+                    access::right(successor) = access::right(n);
+                    access::set_parent(access::right(n), successor);
+                }
+                else
+                    child_parent = successor;
+
+                replace_child(header, access::parent(n), n, successor);
+                access::set_parent(successor, access::parent(n));
+
+                // successor takes the color of n, so the color of its old position is removed
+                removed_red = access::is_red(successor);
+                access::set_red(successor, access::is_red(n));
+            }
+            else
+            {
+                child_parent = access::parent(n);
+                if (child)
+                    access::set_parent(child, child_parent);
+                replace_child(header, child_parent, n, child);
+
+                if (access::left(header) == n)
+                    access::left(header) = access::right(n) ? minimum(child) : child_parent;
+                if (access::right(header) == n)
+                    access::right(header) = access::left(n) ? maximum(child) : child_parent;
+
+                removed_red = access::is_red(n);
+            }
+
+            if (!removed_red)
+            {
+                while (child != access::parent(header) && is_black(child))
+                {
+                    if (child == access::left(child_parent))
+                    {
+                        auto sibling = access::right(child_parent);
+                        if (access::is_red(sibling))
+                        {
+                            access::set_red(sibling, false);
+                            access::set_red(child_parent, true);
+                            rotate_left(header, child_parent);
+                            sibling = access::right(child_parent);
+                        }
+
+                        if (is_black(access::left(sibling)) && is_black(access::right(sibling)))
+                        {
+                            access::set_red(sibling, true);
+                            child        = child_parent;
+                            child_parent = access::parent(child_parent);
+                        }
+                        else
+                        {
+                            if (is_black(access::right(sibling)))
+                            {
+                                access::set_red(access::left(sibling), false);
+                                access::set_red(sibling, true);
+                                rotate_right(header, sibling);
+                                sibling = access::right(child_parent);
+                            }
+                            access::set_red(sibling, access::is_red(child_parent));
+                            access::set_red(child_parent, false);
+                            if (access::right(sibling))
+                                access::set_red(access::right(sibling), false);
+                            rotate_left(header, child_parent);
+                            break;
+                        }
+                    }
+                    else
+                    {
+                        auto sibling = access::left(child_parent);
+                        if (access::is_red(sibling))
+                        {
+                            access::set_red(sibling, false);
+                            access::set_red(child_parent, true);
+                            rotate_right(header, child_parent);
+                            sibling = access::left(child_parent);
+                        }
+
+                        if (is_black(access::right(sibling)) && is_black(access::left(sibling)))
+                        {
+                            access::set_red(sibling, true);
+                            child        = child_parent;
+                            child_parent = access::parent(child_parent);
+                        }
+                        else
+                        {
+                            if (is_black(access::left(sibling)))
+                            {
+                                access::set_red(access::right(sibling), false);
+                                access::set_red(sibling, true);
+                                rotate_left(header, sibling);
+                                sibling = access::left(child_parent);
+                            }
+                            access::set_red(sibling, access::is_red(child_parent));
+                            access::set_red(child_parent, false);
+                            if (access::left(sibling))
+                                access::set_red(access::left(sibling), false);
+                            rotate_right(header, child_parent);
+                            break;
+                        }
+                    }
+                }
+                if (child)
+                    access::set_red(child, false);
+            }
+
+            access::unlink(n);
+        }
+
+        template <typename T>
+        class iterator
+        {
+        public:
+            using value_type        = typename std::remove_cv<T>::type;
+            using reference         = T&;
+            using pointer           = T*;
+            using difference_type   = std::ptrdiff_t;
+            using iterator_category = std::bidirectional_iterator_tag;
+
+            iterator() noexcept : node_(nullptr) {}
+
+            template <typename U,
+                      typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+            iterator(const iterator<U>& other) noexcept : node_(other.node_)
+            {}
+
+            reference operator*() const noexcept
+            {
+                return static_cast<reference>(*node_);
+            }
+            pointer operator->() const noexcept
+            {
+                return &**this;
+            }
+
+            iterator& operator++() noexcept
+            {
+                node_ = increment(node_);
+                return *this;
+            }
+            iterator operator++(int) noexcept
+            {
+                auto result = *this;
+                ++*this;
+                return result;
+            }
+
+            iterator& operator--() noexcept
+            {
+                node_ = decrement(node_);
+                return *this;
+            }
+            iterator operator--(int) noexcept
+            {
+                auto result = *this;
+                --*this;
+                return result;
+            }
+
+            friend bool operator==(const iterator& lhs, const iterator& rhs) noexcept
+            {
+                return lhs.node_ == rhs.node_;
+            }
+            friend bool operator!=(const iterator& lhs, const iterator& rhs) noexcept
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            explicit iterator(node* n) noexcept : node_(n) {}
+
+            node* node_;
+
+            template <typename>
+            friend class iterator;
+            template <typename, class>
+            friend class tiny::rbtree;
+        };
+    } // namespace rbtree_detail
+
+    /// An intrusive ordered multiset implemented as a red-black tree.
+    ///
+    /// It does not own or allocate the elements, they must inherit from [tiny::rbtree_hook]()
+    /// and outlive their membership in the tree.
+    /// As the color is stored in the parent pointer, the per element overhead is three pointers
+    /// instead of the usual four words.
+    /// Use it as an ordered map by comparing elements by their key member and
+    /// a `Compare` that accepts the key type for the lookup functions.
+    /// \requires `T` must publicly inherit from [tiny::rbtree_hook]().
+    template <typename T, class Compare = std::less<T>>
+    class rbtree
+    {
+        using node = rbtree_detail::node;
+
+    public:
+        using value_type     = T;
+        using iterator       = rbtree_detail::iterator<T>;
+        using const_iterator = rbtree_detail::iterator<const T>;
+
+        //=== constructors ===//
+        /// \effects Creates an empty tree.
+        explicit rbtree(Compare compare = Compare()) noexcept : size_(0u), compare_(compare)
+        {
+            static_assert(std::is_base_of<rbtree_hook, T>::value,
+                          "element type must inherit from rbtree_hook");
+            rbtree_detail::init_header(&header_);
+        }
+
+        /// \effects Moves the elements of the other tree into this one, leaving it empty.
+        rbtree(rbtree&& other) noexcept : rbtree(other.compare_)
+        {
+            swap(other);
+        }
+
+        /// \effects Unlinks all elements.
+        ~rbtree() noexcept
+        {
+            clear();
+        }
+
+        /// \effects Unlinks all elements, then moves the elements of the other tree into this
+        /// one, leaving it empty.
+        rbtree& operator=(rbtree&& other) noexcept
+        {
+            clear();
+            swap(other);
+            return *this;
+        }
+
+        /// \effects Exchanges the elements of both trees.
+        void swap(rbtree& other) noexcept
+        {
+            auto root      = rbtree_detail::access::parent(&header_);
+            auto leftmost  = rbtree_detail::access::left(&header_);
+            auto rightmost = rbtree_detail::access::right(&header_);
+            adopt(&header_, other.root(), rbtree_detail::access::left(&other.header_),
+                  rbtree_detail::access::right(&other.header_));
+            adopt(&other.header_, root, leftmost, rightmost);
+
+            std::swap(size_, other.size_);
+            std::swap(compare_, other.compare_);
+        }
+
+        friend void swap(rbtree& lhs, rbtree& rhs) noexcept
+        {
+            lhs.swap(rhs);
+        }
+
+        //=== modifiers ===//
+        /// \effects Inserts the element, unless an equivalent element is already in the tree.
+        /// \returns An iterator to the inserted or equivalent element,
+        /// and whether or not the element was inserted.
+        /// \requires The element must not be linked into a tree.
+        std::pair<iterator, bool> insert_unique(T& value)
+        {
+            DEBUG_ASSERT(!value.is_linked(), detail::precondition_handler{},
+                         "element is already in a tree");
+            auto parent    = &header_;
+            auto cur       = root();
+            auto less_than = true;
+            while (cur)
+            {
+                parent    = cur;
+                less_than = compare_(value, value_of(cur));
+                cur       = less_than ? rbtree_detail::access::left(cur)
+                                : rbtree_detail::access::right(cur);
+            }
+
+            // the element is only unique if it is greater than the predecessor
+            auto predecessor = parent;
+            if (less_than)
+            {
+                if (predecessor == rbtree_detail::access::left(&header_))
+                    return {insert_at(parent, true, value), true};
+                predecessor = rbtree_detail::decrement(predecessor);
+            }
+
+            if (compare_(value_of(predecessor), value))
+                return {insert_at(parent, less_than, value), true};
+            else
+                return {iterator(predecessor), false};
+        }
+
+        /// \effects Inserts the element after all equivalent elements.
+        /// \returns An iterator to the inserted element.
+        /// \requires The element must not be linked into a tree.
+        iterator insert_equal(T& value)
+        {
+            DEBUG_ASSERT(!value.is_linked(), detail::precondition_handler{},
+                         "element is already in a tree");
+            auto parent    = &header_;
+            auto cur       = root();
+            auto less_than = true;
+            while (cur)
+            {
+                parent    = cur;
+                less_than = compare_(value, value_of(cur));
+                cur       = less_than ? rbtree_detail::access::left(cur)
+                                : rbtree_detail::access::right(cur);
+            }
+            return insert_at(parent, less_than, value);
+        }
+
+        /// \effects Unlinks the element at the position.
+        /// \returns An iterator after the erased element.
+        /// \requires The iterator must be dereferenceable.
+        iterator erase(const_iterator pos) noexcept
+        {
+            DEBUG_ASSERT(pos.node_ != &header_, detail::precondition_handler{},
+                         "cannot erase end iterator");
+            auto next = rbtree_detail::increment(pos.node_);
+            rbtree_detail::erase_and_rebalance(&header_, pos.node_);
+            --size_;
+            return iterator(next);
+        }
+
+        /// \effects Unlinks the element.
+        /// \requires The element must be linked into this tree.
+        void erase(T& value) noexcept
+        {
+            DEBUG_ASSERT(value.is_linked(), detail::precondition_handler{},
+                         "element is not in a tree");
+            erase(iterator_to(value));
+        }
+
+        /// \effects Unlinks all elements.
+        void clear() noexcept
+        {
+            // unlink the nodes in post-order without rebalancing
+            auto cur = root();
+            while (cur)
+            {
+                if (rbtree_detail::access::left(cur))
+                    cur = rbtree_detail::access::left(cur);
+                else if (rbtree_detail::access::right(cur))
+                    cur = rbtree_detail::access::right(cur);
+                else
+                {
+                    auto parent = rbtree_detail::access::parent(cur);
+                    if (parent == &header_)
+                        parent = nullptr;
+                    else if (rbtree_detail::access::left(parent) == cur)
+                        rbtree_detail::access::left(parent) = nullptr;
+                    else
+                        rbtree_detail::access::right(parent) = nullptr;
+
+                    rbtree_detail::access::unlink(cur);
+                    cur = parent;
+                }
+            }
+
+            rbtree_detail::init_header(&header_);
+            size_ = 0u;
+        }
+
+        //=== lookup ===//
+        /// \returns An iterator to the first element not less than the key, or `end()`.
+        template <typename Key>
+        iterator lower_bound(const Key& key) noexcept
+        {
+            auto result = &header_;
+            for (auto cur = root(); cur;)
+                if (!compare_(value_of(cur), key))
+                {
+                    result = cur;
+                    cur    = rbtree_detail::access::left(cur);
+                }
+                else
+                    cur = rbtree_detail::access::right(cur);
+            return iterator(result);
+        }
+        template <typename Key>
+        const_iterator lower_bound(const Key& key) const noexcept
+        {
+            return const_cast<rbtree&>(*this).lower_bound(key);
+        }
+
+        /// \returns An iterator to the first element greater than the key, or `end()`.
+        template <typename Key>
+        iterator upper_bound(const Key& key) noexcept
+        {
+            auto result = &header_;
+            for (auto cur = root(); cur;)
+                if (compare_(key, value_of(cur)))
+                {
+                    result = cur;
+                    cur    = rbtree_detail::access::left(cur);
+                }
+                else
+                    cur = rbtree_detail::access::right(cur);
+            return iterator(result);
+        }
+        template <typename Key>
+        const_iterator upper_bound(const Key& key) const noexcept
+        {
+            return const_cast<rbtree&>(*this).upper_bound(key);
+        }
+
+        /// \returns An iterator to the first element equivalent to the key, or `end()`.
+        template <typename Key>
+        iterator find(const Key& key) noexcept
+        {
+            auto result = lower_bound(key);
+            return result == end() || compare_(key, *result) ? end() : result;
+        }
+        template <typename Key>
+        const_iterator find(const Key& key) const noexcept
+        {
+            return const_cast<rbtree&>(*this).find(key);
+        }
+
+        /// \returns An iterator to the element.
+        /// \requires The element must be linked into this tree.
+        iterator iterator_to(T& value) noexcept
+        {
+            return iterator(&static_cast<node&>(value));
+        }
+        const_iterator iterator_to(const T& value) const noexcept
+        {
+            return iterator(const_cast<node*>(&static_cast<const node&>(value)));
+        }
+
+        //=== iterators ===//
+        iterator begin() noexcept
+        {
+            return iterator(rbtree_detail::access::left(&header_));
+        }
+        const_iterator begin() const noexcept
+        {
+            return const_cast<rbtree&>(*this).begin();
+        }
+        const_iterator cbegin() const noexcept
+        {
+            return begin();
+        }
+
+        iterator end() noexcept
+        {
+            return iterator(&header_);
+        }
+        const_iterator end() const noexcept
+        {
+            return const_cast<rbtree&>(*this).end();
+        }
+        const_iterator cend() const noexcept
+        {
+            return end();
+        }
+
+        //=== capacity ===//
+        /// \returns Whether or not the tree is empty.
+        bool empty() const noexcept
+        {
+            return size_ == 0u;
+        }
+
+        /// \returns The number of elements.
+        std::size_t size() const noexcept
+        {
+            return size_;
+        }
+
+    private:
+        static T& value_of(node* n) noexcept
+        {
+            return static_cast<T&>(*n);
+        }
+
+        node* root() const noexcept
+        {
+            return rbtree_detail::access::parent(&header_);
+        }
+
+        iterator insert_at(node* parent, bool insert_left, T& value) noexcept
+        {
+            auto n = &static_cast<node&>(value);
+            rbtree_detail::insert_and_rebalance(&header_, parent, insert_left || parent == &header_,
+                                                n);
+            ++size_;
+            return iterator(n);
+        }
+
+        // makes header the header of the tree with the given root
+        static void adopt(node* header, node* root, node* leftmost, node* rightmost) noexcept
+        {
+            if (root == nullptr)
+                rbtree_detail::init_header(header);
+            else
+            {
+                rbtree_detail::access::set_parent(header, root);
+                rbtree_detail::access::set_parent(root, header);
+                rbtree_detail::access::left(header)  = leftmost;
+                rbtree_detail::access::right(header) = rightmost;
+            }
+        }
+
+        node        header_;
+        std::size_t size_;
+        Compare     compare_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_RBTREE_HPP_INCLUDED
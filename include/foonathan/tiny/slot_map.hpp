@@ -0,0 +1,311 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_SLOT_MAP_HPP_INCLUDED
+#define FOONATHAN_TINY_SLOT_MAP_HPP_INCLUDED
+
+#include <climits>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <typename T, std::size_t IndexBits, std::size_t GenerationBits>
+    class slot_map;
+
+    /// \exclude
+    namespace slot_map_detail
+    {
+        // the index of a slot and its generation,
+        // for a free slot the index is the next free slot instead
+        template <std::size_t IndexBits, std::size_t GenerationBits>
+        using slot = tiny_storage<tiny_unsigned<IndexBits, std::size_t>,
+                                  tiny_unsigned<GenerationBits, std::size_t>>;
+    } // namespace slot_map_detail
+
+    /// A handle to an element of a [tiny::slot_map]().
+    ///
+    /// It packs the index of the slot and its generation into a [tiny::tiny_storage](),
+    /// so with the default 22/10 split it is only 32 bits.
+    template <std::size_t IndexBits, std::size_t GenerationBits>
+    class slot_map_handle
+    {
+        static_assert(IndexBits + GenerationBits <= sizeof(std::size_t) * CHAR_BIT,
+                      "handle too big");
+
+    public:
+        /// \effects Creates a handle that is never valid.
+        slot_map_handle() noexcept : storage_(invalid_index(), 0u) {}
+
+        /// \returns The index of the slot.
+        std::size_t index() const noexcept
+        {
+            return storage_.template at<0>();
+        }
+
+        /// \returns The generation of the slot.
+        std::size_t generation() const noexcept
+        {
+            return storage_.template at<1>();
+        }
+
+        friend bool operator==(const slot_map_handle& lhs, const slot_map_handle& rhs) noexcept
+        {
+            return lhs.index() == rhs.index() && lhs.generation() == rhs.generation();
+        }
+        friend bool operator!=(const slot_map_handle& lhs, const slot_map_handle& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        // the largest index, used as sentinel
+        static constexpr std::size_t invalid_index() noexcept
+        {
+            return (std::size_t(1) << IndexBits) - 1u;
+        }
+
+        explicit slot_map_handle(slot_map_detail::slot<IndexBits, GenerationBits> storage) noexcept
+        : storage_(storage)
+        {}
+
+        slot_map_detail::slot<IndexBits, GenerationBits> storage_;
+
+        template <typename, std::size_t, std::size_t>
+        friend class slot_map;
+    };
+
+    /// A container that hands out generational handles to its elements.
+    ///
+    /// The elements are stored in a dense array, so iteration is as fast as for a `std::vector`,
+    /// erasure moves the last element into the hole.
+    /// A sparse array of slots maps the handle index to the dense index and stores the generation,
+    /// which is incremented when an element is erased, so stale handles are detected
+    /// by a single comparison.
+    /// The free slots form a linked list threaded through the index of the slots.
+    ///
+    /// It can store up to `2^IndexBits - 1` elements.
+    /// After `2^GenerationBits` erasures of a slot its generation wraps around,
+    /// so a stale handle of that generation is considered valid again.
+    template <typename T, std::size_t IndexBits = 22, std::size_t GenerationBits = 10>
+    class slot_map
+    {
+        using slot = slot_map_detail::slot<IndexBits, GenerationBits>;
+
+    public:
+        using value_type     = T;
+        using handle         = slot_map_handle<IndexBits, GenerationBits>;
+        using iterator       = typename std::vector<T>::iterator;
+        using const_iterator = typename std::vector<T>::const_iterator;
+
+        //=== constructors ===//
+        /// \effects Creates an empty slot map.
+        slot_map() noexcept : free_head_(handle::invalid_index()) {}
+
+        //=== modifiers ===//
+        /// \effects Inserts a new element constructed from the arguments.
+        /// \returns The handle of the element.
+        /// \requires `size() < max_size()`.
+        template <typename... Args>
+        handle emplace(Args&&... args)
+        {
+            DEBUG_ASSERT(size() < max_size(), detail::precondition_handler{}, "slot map full");
+
+            // grow the bookkeeping first, it is shrunk again if anything throws
+            growth_guard guard{this, slots_.size(), dense_to_index_.size()};
+            auto         index = free_head_;
+            if (index == handle::invalid_index())
+            {
+                index = slots_.size();
+                slots_.emplace_back(0u, 0u);
+            }
+            dense_to_index_.push_back(index);
+            values_.emplace_back(std::forward<Args>(args)...);
+            guard.map = nullptr;
+
+            // nothing can throw anymore
+            if (index == free_head_)
+                free_head_ = slots_[index].template at<0>();
+            slots_[index].template at<0>() = values_.size() - 1u;
+            return handle(slot(index, slots_[index].template at<1>()));
+        }
+
+        /// \effects Inserts a copy of the element.
+        /// \returns The handle of the element.
+        handle insert(const T& value)
+        {
+            return emplace(value);
+        }
+        /// \effects Inserts the element by moving it.
+        /// \returns The handle of the element.
+        handle insert(T&& value)
+        {
+            return emplace(std::move(value));
+        }
+
+        /// \effects Erases the element with the given handle, if it is still valid.
+        /// This invalidates the handle.
+        /// \returns Whether or not an element was erased.
+        bool erase(handle h)
+        {
+            if (!contains(h))
+                return false;
+
+            auto        index = h.index();
+            std::size_t dense = slots_[index].template at<0>();
+            if (dense != values_.size() - 1u)
+            {
+                // move the last element into the hole
+                values_[dense]         = std::move(values_.back());
+                dense_to_index_[dense] = dense_to_index_.back();
+                slots_[dense_to_index_[dense]].template at<0>() = dense;
+            }
+            values_.pop_back();
+            dense_to_index_.pop_back();
+
+            release(index);
+            return true;
+        }
+
+        /// \effects Erases all elements, this invalidates all handles.
+        void clear() noexcept
+        {
+            for (auto index : dense_to_index_)
+                release(index);
+            values_.clear();
+            dense_to_index_.clear();
+        }
+
+        /// \effects Reserves memory for the given number of elements.
+        void reserve(std::size_t capacity)
+        {
+            values_.reserve(capacity);
+            dense_to_index_.reserve(capacity);
+            slots_.reserve(capacity);
+        }
+
+        //=== lookup ===//
+        /// \returns Whether or not the handle refers to an element.
+        bool contains(handle h) const noexcept
+        {
+            // free slots have a different generation than any handle to them
+            return h.index() < slots_.size()
+                   && slots_[h.index()].template at<1>() == h.generation();
+        }
+
+        /// \returns A pointer to the element with the given handle,
+        /// or `nullptr` if the handle isn't valid.
+        T* get(handle h) noexcept
+        {
+            return contains(h) ? &values_[slots_[h.index()].template at<0>()] : nullptr;
+        }
+        const T* get(handle h) const noexcept
+        {
+            return contains(h) ? &values_[slots_[h.index()].template at<0>()] : nullptr;
+        }
+
+        /// \returns A reference to the element with the given handle.
+        /// \requires The handle must be valid.
+        T& operator[](handle h) noexcept
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            return values_[slots_[h.index()].template at<0>()];
+        }
+        const T& operator[](handle h) const noexcept
+        {
+            DEBUG_ASSERT(contains(h), detail::precondition_handler{}, "invalid handle");
+            return values_[slots_[h.index()].template at<0>()];
+        }
+
+        /// \returns The handle of the element at the given position of the dense array.
+        /// \requires `i < size()`.
+        handle handle_at(std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < size(), detail::precondition_handler{}, "index out of range");
+            auto index = dense_to_index_[i];
+            return handle(slot(index, slots_[index].template at<1>()));
+        }
+
+        //=== iterators ===//
+        /// \returns An iterator to the dense array of elements, in no particular order.
+        iterator begin() noexcept
+        {
+            return values_.begin();
+        }
+        const_iterator begin() const noexcept
+        {
+            return values_.begin();
+        }
+
+        iterator end() noexcept
+        {
+            return values_.end();
+        }
+        const_iterator end() const noexcept
+        {
+            return values_.end();
+        }
+
+        //=== capacity ===//
+        /// \returns Whether or not the slot map is empty.
+        bool empty() const noexcept
+        {
+            return values_.empty();
+        }
+
+        /// \returns The number of elements.
+        std::size_t size() const noexcept
+        {
+            return values_.size();
+        }
+
+        /// \returns The maximal number of elements.
+        static constexpr std::size_t max_size() noexcept
+        {
+            return handle::invalid_index();
+        }
+
+    private:
+        // undoes the growth of the bookkeeping in emplace() unless dismissed
+        struct growth_guard
+        {
+            slot_map*   map;
+            std::size_t slots_size;
+            std::size_t dense_size;
+
+            ~growth_guard() noexcept
+            {
+                if (map)
+                {
+                    map->slots_.resize(slots_size);
+                    map->dense_to_index_.resize(dense_size);
+                }
+            }
+        };
+
+        // increments the generation and adds the slot to the free list
+        void release(std::size_t index) noexcept
+        {
+            auto generation = slots_[index].template at<1>() + 1u;
+            slots_[index].template at<1>() = generation & ((std::size_t(1) << GenerationBits) - 1u);
+            slots_[index].template at<0>() = free_head_;
+            free_head_                     = index;
+        }
+
+        std::vector<T>           values_;
+        std::vector<std::size_t> dense_to_index_;
+        std::vector<slot>        slots_;
+        std::size_t              free_head_;
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_SLOT_MAP_HPP_INCLUDED
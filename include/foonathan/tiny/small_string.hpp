@@ -0,0 +1,366 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_SMALL_STRING_HPP_INCLUDED
+#define FOONATHAN_TINY_SMALL_STRING_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <type_traits>
+
+#include <foonathan/tiny/detail/assert.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace string_detail
+    {
+        // heap layout: pointer, size, capacity in the remaining bytes except the last one
+        constexpr std::size_t object_size     = 3u * sizeof(void*);
+        constexpr std::size_t size_offset     = sizeof(void*);
+        constexpr std::size_t capacity_offset = 2u * sizeof(void*);
+        constexpr std::size_t capacity_bytes  = sizeof(void*) - 1u;
+
+        // the last byte: the number of unused inline characters and the heap flag,
+        // both are zero for a full inline string, so it is the null terminator
+        using last_byte = tiny_storage<tiny_unsigned<7>, tiny_bool>;
+        static_assert(sizeof(last_byte) == 1u, "last byte must be a single byte");
+    } // namespace string_detail
+
+    /// A string with small string optimization that is three pointers big.
+    ///
+    /// Strings of up to 23 characters (on a 64 bit platform) are stored inline.
+    /// The last byte is a [tiny::tiny_storage]() of the number of unused inline characters
+    /// and a flag whether or not the characters are on the heap.
+    /// For a full inline string it is zero and doubles as the null terminator.
+    /// On the heap, it stores the pointer, the size and the capacity in the remaining bytes.
+    ///
+    /// It never points into itself, so it is trivially relocatable.
+    class small_string
+    {
+    public:
+        using value_type     = char;
+        using iterator       = char*;
+        using const_iterator = const char*;
+
+        //=== constructors ===//
+        /// \effects Creates an empty string.
+        small_string() noexcept : bytes_{}
+        {
+            set_inline_size(0u);
+        }
+
+        /// \effects Creates a string containing a copy of the null-terminated string.
+        small_string(const char* str) : small_string(str, std::strlen(str)) {}
+
+        /// \effects Creates a string containing a copy of the characters.
+        small_string(const char* str, std::size_t size) : small_string()
+        {
+            append(str, size);
+        }
+
+        small_string(const small_string& other) : small_string(other.data(), other.size()) {}
+
+        /// \effects Creates a string containing the characters of the other one,
+        /// leaving it empty.
+        small_string(small_string&& other) noexcept
+        {
+            std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+            other.reset();
+        }
+
+        ~small_string() noexcept
+        {
+            if (is_heap())
+                std::free(heap_pointer());
+        }
+
+        small_string& operator=(const small_string& other)
+        {
+            if (this != &other)
+                assign(other.data(), other.size());
+            return *this;
+        }
+
+        small_string& operator=(small_string&& other) noexcept
+        {
+            if (this != &other)
+            {
+                if (is_heap())
+                    std::free(heap_pointer());
+                std::memcpy(bytes_, other.bytes_, sizeof(bytes_));
+                other.reset();
+            }
+            return *this;
+        }
+
+        //=== modifiers ===//
+        /// \effects Replaces the characters by a copy of the given ones.
+        /// \requires The characters must not be part of the string.
+        void assign(const char* str, std::size_t size)
+        {
+            clear();
+            append(str, size);
+        }
+
+        /// \effects Appends a copy of the characters.
+        void append(const char* str, std::size_t size)
+        {
+            auto old_size = this->size();
+            // the characters might be part of the string, which can be reallocated
+            std::less<const char*> less;
+            if (!less(str, begin()) && less(str, end()))
+            {
+                auto offset = std::size_t(str - data());
+                reserve(old_size + size);
+                str = data() + offset;
+            }
+            else
+                reserve(old_size + size);
+            std::memmove(data() + old_size, str, size);
+            set_size(old_size + size);
+        }
+
+        /// \effects Appends a copy of the null-terminated string.
+        void append(const char* str)
+        {
+            append(str, std::strlen(str));
+        }
+
+        /// \effects Appends the character.
+        void push_back(char c)
+        {
+            append(&c, 1u);
+        }
+
+        /// \effects Removes the last character.
+        /// \requires `!empty()`.
+        void pop_back() noexcept
+        {
+            DEBUG_ASSERT(!empty(), detail::precondition_handler{}, "string is empty");
+            set_size(size() - 1u);
+        }
+
+        /// \effects Removes all characters, but keeps the memory.
+        void clear() noexcept
+        {
+            set_size(0u);
+        }
+
+        /// \effects Ensures that the capacity is at least `new_capacity`.
+        /// \requires `new_capacity <= max_size()`.
+        void reserve(std::size_t new_capacity)
+        {
+            if (new_capacity <= capacity())
+                return;
+            DEBUG_ASSERT(new_capacity <= max_size(), detail::precondition_handler{},
+                         "string too long");
+
+            // grow at least by factor two
+            if (new_capacity < 2u * capacity())
+                new_capacity = 2u * capacity();
+            if (new_capacity > max_size())
+                new_capacity = max_size();
+
+            auto size = this->size();
+            auto memory
+                = static_cast<char*>(is_heap() ? std::realloc(heap_pointer(), new_capacity + 1u)
+                                               : std::malloc(new_capacity + 1u));
+            if (!memory)
+                throw std::bad_alloc();
+            else if (!is_heap())
+                std::memcpy(memory, bytes_, size + 1u);
+
+            set_heap(memory, size, new_capacity);
+        }
+
+        //=== accessors ===//
+        /// \returns A pointer to the null-terminated characters.
+        char* data() noexcept
+        {
+            return is_heap() ? heap_pointer() : bytes_;
+        }
+        const char* data() const noexcept
+        {
+            return is_heap() ? heap_pointer() : bytes_;
+        }
+        const char* c_str() const noexcept
+        {
+            return data();
+        }
+
+        /// \returns The character at the given position.
+        /// \requires `i < size()`.
+        char& operator[](std::size_t i) noexcept
+        {
+            DEBUG_ASSERT(i < size(), detail::precondition_handler{}, "index out of range");
+            return data()[i];
+        }
+        const char& operator[](std::size_t i) const noexcept
+        {
+            DEBUG_ASSERT(i < size(), detail::precondition_handler{}, "index out of range");
+            return data()[i];
+        }
+
+        iterator begin() noexcept
+        {
+            return data();
+        }
+        const_iterator begin() const noexcept
+        {
+            return data();
+        }
+
+        iterator end() noexcept
+        {
+            return data() + size();
+        }
+        const_iterator end() const noexcept
+        {
+            return data() + size();
+        }
+
+        //=== capacity ===//
+        /// \returns Whether or not the string is empty.
+        bool empty() const noexcept
+        {
+            return size() == 0u;
+        }
+
+        /// \returns The number of characters, excluding the null terminator.
+        std::size_t size() const noexcept
+        {
+            if (is_heap())
+                return load(string_detail::size_offset, sizeof(std::size_t));
+            else
+                return inline_capacity() - std::size_t(last().at<0>());
+        }
+
+        /// \returns The number of characters it can store without allocating memory.
+        std::size_t capacity() const noexcept
+        {
+            return is_heap() ? load(string_detail::capacity_offset, string_detail::capacity_bytes)
+                             : inline_capacity();
+        }
+
+        /// \returns The number of characters that can be stored inline.
+        static constexpr std::size_t inline_capacity() noexcept
+        {
+            return string_detail::object_size - 1u;
+        }
+
+        /// \returns The maximal number of characters.
+        static constexpr std::size_t max_size() noexcept
+        {
+            return (std::size_t(1) << (8u * string_detail::capacity_bytes)) - 2u;
+        }
+
+        /// \returns Whether or not the characters are stored on the heap.
+        bool is_heap() const noexcept
+        {
+            return last().at<1>();
+        }
+
+        //=== comparison ===//
+        friend bool operator==(const small_string& lhs, const small_string& rhs) noexcept
+        {
+            return lhs.size() == rhs.size() && std::memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+        }
+        friend bool operator!=(const small_string& lhs, const small_string& rhs) noexcept
+        {
+            return !(lhs == rhs);
+        }
+
+        friend bool operator<(const small_string& lhs, const small_string& rhs) noexcept
+        {
+            auto min_size = lhs.size() < rhs.size() ? lhs.size() : rhs.size();
+            auto result   = std::memcmp(lhs.data(), rhs.data(), min_size);
+            return result < 0 || (result == 0 && lhs.size() < rhs.size());
+        }
+
+    private:
+        string_detail::last_byte last() const noexcept
+        {
+            string_detail::last_byte result;
+            std::memcpy(&result, bytes_ + inline_capacity(), 1u);
+            return result;
+        }
+        void set_last(const string_detail::last_byte& byte) noexcept
+        {
+            std::memcpy(bytes_ + inline_capacity(), &byte, 1u);
+        }
+
+        // little endian, so it does not overlap the last byte on any platform
+        std::size_t load(std::size_t offset, std::size_t size) const noexcept
+        {
+            std::size_t result = 0;
+            for (auto i = std::size_t(0); i != size; ++i)
+                result |= std::size_t(static_cast<unsigned char>(bytes_[offset + i])) << (8u * i);
+            return result;
+        }
+        void store(std::size_t offset, std::size_t size, std::size_t value) noexcept
+        {
+            for (auto i = std::size_t(0); i != size; ++i)
+                bytes_[offset + i]
+                    = static_cast<char>(static_cast<unsigned char>(value >> (8u * i)));
+        }
+
+        char* heap_pointer() const noexcept
+        {
+            char* result;
+            std::memcpy(&result, bytes_, sizeof(result));
+            return result;
+        }
+
+        void set_heap(char* ptr, std::size_t size, std::size_t capacity) noexcept
+        {
+            std::memcpy(bytes_, &ptr, sizeof(ptr));
+            store(string_detail::size_offset, sizeof(std::size_t), size);
+            store(string_detail::capacity_offset, string_detail::capacity_bytes, capacity);
+            set_last(string_detail::last_byte(0u, true));
+        }
+
+        void set_inline_size(std::size_t size) noexcept
+        {
+            bytes_[size] = '\0';
+            set_last(string_detail::last_byte(unsigned(inline_capacity() - size), false));
+        }
+
+        void set_size(std::size_t size) noexcept
+        {
+            if (is_heap())
+            {
+                heap_pointer()[size] = '\0';
+                store(string_detail::size_offset, sizeof(std::size_t), size);
+            }
+            else
+                set_inline_size(size);
+        }
+
+        // sets to the empty inline string without freeing memory
+        void reset() noexcept
+        {
+            set_inline_size(0u);
+        }
+
+        char bytes_[string_detail::object_size];
+    };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::small_string]().
+    template <>
+    struct is_trivially_relocatable<small_string> : std::true_type
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_SMALL_STRING_HPP_INCLUDED
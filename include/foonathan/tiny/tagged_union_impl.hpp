@@ -7,8 +7,10 @@
 
 #include <new>
 
+#include <foonathan/tiny/detail/index_sequence.hpp>
 #include <foonathan/tiny/tiny_int.hpp>
 #include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/tombstone.hpp>
 
 namespace foonathan
 {
@@ -29,7 +31,7 @@ namespace tiny
     struct union_types
     {
         /// \exclude
-        using tag = tiny_int_range<0, std::intmax_t(sizeof...(T)), std::size_t>;
+        using tag = tiny_int_range<0, std::intmax_t(sizeof...(T)) - 1, std::size_t>;
 
         /// \exclude
         using storage = tagged_union_detail::types_storage<union_types<T...>, 0, T...>;
@@ -105,10 +107,21 @@ namespace tiny
             return make_tiny_proxy<tiny_tag>(tag_cview(storage_));
         }
 
+        // raw access to the tag bits, allows the unused encodings as well
+        void set_tag_encoding(std::uintmax_t encoding) noexcept
+        {
+            tag_view(storage_).put(encoding);
+        }
+        std::uintmax_t get_tag_encoding() const noexcept
+        {
+            return tag_cview(storage_).extract();
+        }
+
         template <class, std::size_t, typename...>
         friend union tagged_union_detail::types_storage;
         template <class>
         friend class tagged_union_impl;
+        friend struct tombstone_traits<tagged_union_impl<UnionTypes>>;
     };
 
     /// \exclude
@@ -210,8 +223,132 @@ namespace tiny
 
         template <class UnionTypes>
         using types_storage_for = typename UnionTypes::storage;
+
+        //=== visit ===//
+        template <std::size_t I, typename... T>
+        struct nth_type;
+
+        template <typename Head, typename... Tail>
+        struct nth_type<0, Head, Tail...>
+        {
+            using type = Head;
+        };
+
+        template <std::size_t I, typename Head, typename... Tail>
+        struct nth_type<I, Head, Tail...> : nth_type<I - 1, Tail...>
+        {};
+
+        template <class UnionTypes>
+        struct union_types_traits;
+
+        template <typename... T>
+        struct union_types_traits<union_types<T...>>
+        {
+            static constexpr std::size_t count = sizeof...(T);
+
+            template <std::size_t I>
+            using type = typename nth_type<I, T...>::type;
+        };
+
+        template <class Union>
+        using union_traits_of
+            = union_types_traits<typename std::remove_const<Union>::type::value_types>;
+
+        // value of the I-th type, const if the union is const
+        template <std::size_t I, class Union>
+        auto get_alternative(Union& u) noexcept
+            -> decltype(u.template value<typename union_traits_of<Union>::template type<I>>())
+        {
+            return u.template value<typename union_traits_of<Union>::template type<I>>();
+        }
+
+        // product of the number of types of all unions
+        template <class... Unions>
+        struct product : std::integral_constant<std::size_t, 1u>
+        {};
+
+        template <class Head, class... Tail>
+        struct product<Head, Tail...>
+        : std::integral_constant<std::size_t,
+                                 union_traits_of<Head>::count * product<Tail...>::value>
+        {};
+
+        // product of the number of types of all unions starting at index I
+        template <std::size_t I, class... Unions>
+        struct product_from : std::integral_constant<std::size_t, 1u>
+        {};
+
+        template <std::size_t I, class Head, class... Tail>
+        struct product_from<I, Head, Tail...>
+        : std::conditional<I == 0u, product<Head, Tail...>, product_from<I - 1u, Tail...>>::type
+        {};
+
+        // the index into the table is a mixed radix number with a digit for each union
+        inline std::size_t visit_index() noexcept
+        {
+            return 0u;
+        }
+        template <class Head, class... Tail>
+        std::size_t visit_index(Head& head, Tail&... tail) noexcept
+        {
+            auto tag = head.tag();
+            DEBUG_ASSERT(tag < union_traits_of<Head>::count, detail::precondition_handler{});
+            return tag * product<Tail...>::value + visit_index(tail...);
+        }
+
+        template <class Visitor, class... Unions>
+        using visit_result
+            = decltype(std::declval<Visitor>()(get_alternative<0>(std::declval<Unions&>())...));
+
+        template <class Visitor, class... Unions>
+        class visit_table
+        {
+            using result   = visit_result<Visitor, Unions...>;
+            using function = result (*)(Visitor&&, Unions&...);
+
+            template <std::size_t Index, std::size_t... Positions>
+            static result invoke(Visitor&& visitor, Unions&... unions)
+            {
+                return static_cast<Visitor&&>(visitor)(
+                    get_alternative<(Index / product_from<Positions + 1u, Unions...>::value)
+                                    % union_traits_of<Unions>::count>(unions)...);
+            }
+
+            template <std::size_t... Indices, std::size_t... Positions>
+            static const function* get(detail::index_sequence<Indices...>,
+                                       detail::index_sequence<Positions...>) noexcept
+            {
+                static constexpr function table[] = {&invoke<Indices, Positions...>...};
+                return table;
+            }
+
+        public:
+            static const function* get() noexcept
+            {
+                return get(detail::make_index_sequence<product<Unions...>::value>{},
+                           detail::make_index_sequence<sizeof...(Unions)>{});
+            }
+        };
     } // namespace tagged_union_detail
 
+    /// Visits the values stored in one or more [tiny::tagged_union_impl]().
+    ///
+    /// \effects Invokes `visitor(u.value<T>()...)` where `T` is the type currently stored in each
+    /// union `u`. It reads the tag of each union once and then dispatches through a table of
+    /// function pointers, so it is a single indirect call regardless of the number of types.
+    /// \returns The result of the invocation.
+    /// \requires None of the unions is in the invalid state,
+    /// and the visitor returns the same type for all combinations of types.
+    template <class Visitor, class... Unions>
+    auto visit(Visitor&& visitor, Unions&... unions)
+        -> tagged_union_detail::visit_result<Visitor, Unions...>
+    {
+        static_assert(sizeof...(Unions) > 0u, "need at least one union");
+        auto table = tagged_union_detail::visit_table<Visitor, Unions...>::get();
+        return table[tagged_union_detail::visit_index(unions...)](static_cast<Visitor&&>(visitor),
+                                                                  unions...);
+    }
+
     /// An intrusive tagged union implementation helper.
     ///
     /// It is just a low-level implementation helper.
@@ -298,10 +435,88 @@ namespace tiny
             return storage_.get(tagged_union_detail::type_tag<T>{});
         }
 
+        //=== visit ===//
+        /// \effects Invokes `visitor(value<T>())`, where `T` is the type currently stored.
+        /// \returns The result of the invocation.
+        /// \requires The union is not in the invalid state,
+        /// and the visitor returns the same type for all types.
+        /// \notes This is the same as [tiny::visit]() with a single union.
+        /// \group visit
+        template <class Visitor, class Self = tagged_union_impl>
+        auto visit(Visitor&& visitor) -> tagged_union_detail::visit_result<Visitor, Self>
+        {
+            return tiny::visit(static_cast<Visitor&&>(visitor), *this);
+        }
+        /// \group visit
+        template <class Visitor, class Self = const tagged_union_impl>
+        auto visit(Visitor&& visitor) const -> tagged_union_detail::visit_result<Visitor, Self>
+        {
+            return tiny::visit(static_cast<Visitor&&>(visitor), *this);
+        }
+
     private:
         tagged_union_detail::types_storage_for<UnionTypes> storage_;
     };
 
+    /// Specialization of the tombstone traits for [tiny::tagged_union_impl]().
+    ///
+    /// It uses the unused encodings of the tag, the spare bits are left alone.
+    /// An object created by `create_object()` is in the invalid state,
+    /// but its tag is set to zero so it doesn't look like a tombstone.
+    template <class UnionTypes>
+    struct tombstone_traits<tagged_union_impl<UnionTypes>>
+    {
+    private:
+        using tag_type = tagged_union_tag<UnionTypes>;
+        using tiny_tag = typename UnionTypes::tag;
+
+        static constexpr std::uintmax_t first_tombstone = tiny_max_encoding<tiny_tag>() + 1u;
+
+    public:
+        using object_type     = tagged_union_impl<UnionTypes>;
+        using storage_type    = tombstone_detail::dual_storage_type_for<object_type, tag_type>;
+        using reference       = object_type&;
+        using const_reference = const object_type&;
+
+        static constexpr std::size_t tombstone_count = tombstone_detail::clamp_tombstone_count(
+            detail::all_bits_set(tiny_tag::bit_size()) + 1u - first_tombstone);
+
+        static void create_tombstone(storage_type& storage, std::size_t tombstone_index) noexcept
+        {
+            ::new (static_cast<void*>(&storage.tombstone)) tag_type();
+            storage.tombstone.set_tag_encoding(first_tombstone + tombstone_index);
+        }
+
+        static void create_object(storage_type& storage)
+        {
+            ::new (static_cast<void*>(&storage.object)) object_type();
+            // the tag is the first member of every type, so it is layout compatible
+            storage.tombstone.set_tag_encoding(0u);
+        }
+
+        static void destroy_object(storage_type& storage) noexcept
+        {
+            storage.object.~object_type();
+        }
+
+        static std::size_t get_tombstone(const storage_type& storage) noexcept
+        {
+            // valid tags are smaller, so they overflow
+            return tombstone_detail::to_tombstone_index(
+                std::uintmax_t(storage.tombstone.get_tag_encoding() - first_tombstone),
+                tombstone_count);
+        }
+
+        static reference get_object(storage_type& storage) noexcept
+        {
+            return storage.object;
+        }
+        static const_reference get_object(const storage_type& storage) noexcept
+        {
+            return storage.object;
+        }
+    };
+
     /// Dummy type to allow an empty [tiny::tagged_union_impl]().
     template <class UnionTypes>
     struct tagged_union_empty
@@ -0,0 +1,258 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_TINY_APPROX_COUNTER_HPP_INCLUDED
+#define FOONATHAN_TINY_TINY_APPROX_COUNTER_HPP_INCLUDED
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <ratio>
+#include <type_traits>
+
+#include <foonathan/tiny/tiny_type.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// A fast pseudo random number generator using the xorshift64* algorithm.
+    ///
+    /// It satisfies the requirements of `UniformRandomBitGenerator` and is meant as a cheap source
+    /// of randomness for probabilistic data structures, it is not cryptographically secure.
+    class xorshift_engine
+    {
+    public:
+        using result_type = std::uint64_t;
+
+        static constexpr result_type min() noexcept
+        {
+            return 1u;
+        }
+        static constexpr result_type max() noexcept
+        {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        /// \effects Creates it with the given seed.
+        /// \notes The state must not be zero, so a seed of zero is replaced by a different value.
+        explicit xorshift_engine(std::uint64_t seed = 0x9E3779B97F4A7C15u) noexcept
+        : state_(seed == 0u ? 0x9E3779B97F4A7C15u : seed)
+        {}
+
+        result_type operator()() noexcept
+        {
+            state_ ^= state_ >> 12;
+            state_ ^= state_ << 25;
+            state_ ^= state_ >> 27;
+            return state_ * 0x2545F4914F6CDD1Du;
+        }
+
+    private:
+        std::uint64_t state_;
+    };
+
+    /// \returns A reference to an [tiny::xorshift_engine]() that is local to the current thread.
+    /// \notes Each thread's engine is seeded differently.
+    inline xorshift_engine& thread_local_engine() noexcept
+    {
+        static thread_local xorshift_engine engine(
+            std::uint64_t(reinterpret_cast<std::uintptr_t>(&engine)));
+        return engine;
+    }
+
+    /// \exclude
+    namespace approx_detail
+    {
+        // a probability as fraction of 2^64, clamped to the maximum
+        inline std::uint64_t to_threshold(double probability) noexcept
+        {
+            auto scaled = std::ldexp(probability, 64);
+            return scaled >= std::ldexp(1., 64) ? std::numeric_limits<std::uint64_t>::max()
+                                                : std::uint64_t(scaled);
+        }
+
+        // whether the generator produces (almost) all 64 bit values,
+        // xorshift_engine never returns zero, which is a negligible bias
+        template <class Rng>
+        using is_64bit_generator = std::integral_constant<
+            bool, std::uint64_t(Rng::min()) <= 1u
+                      && std::uint64_t(Rng::max()) == std::numeric_limits<std::uint64_t>::max()>;
+
+        template <class Rng>
+        std::uint64_t random_bits(Rng& rng, std::true_type) noexcept(noexcept(rng()))
+        {
+            return std::uint64_t(rng() - Rng::min());
+        }
+        template <class Rng>
+        std::uint64_t random_bits(Rng& rng, std::false_type)
+        {
+            return std::uniform_int_distribution<std::uint64_t>()(rng);
+        }
+
+        // 64 uniformly distributed random bits
+        template <class Rng>
+        std::uint64_t random_bits(Rng& rng) noexcept(noexcept(rng()))
+        {
+            return random_bits(rng, is_64bit_generator<Rng>{});
+        }
+    } // namespace approx_detail
+
+    /// A `TinyType` implementation of a probabilistic counter using Morris' algorithm.
+    ///
+    /// It stores only the exponent `c` of the count, which is the object type,
+    /// and represents a count of `(Base^c - 1) / (Base - 1)`.
+    /// An increment increases the exponent with probability `Base^-c`,
+    /// so the estimate is unbiased with a relative standard deviation of about
+    /// `sqrt((Base - 1) / 2)`. A smaller `Base` is more accurate but can count less.
+    /// For example, with 8 bits and a base of `1.08` it can count up to `4 * 10^9`
+    /// with a relative error of about 20%.
+    ///
+    /// An increment compares a single 64 bit random number with a precomputed threshold:
+    /// for a base of two it is a power of two, otherwise it is looked up in a table
+    /// that is computed on first use for the first 4096 exponents.
+    ///
+    /// \requires `Base` must be a [std::ratio]() greater than one.
+    template <std::size_t Bits, class Base = std::ratio<2>>
+    class tiny_approx_counter
+    {
+        static_assert(Base::num > Base::den, "base must be greater than one");
+        static_assert(Bits <= sizeof(unsigned) * CHAR_BIT, "too many bits");
+
+    public:
+        using object_type = unsigned;
+
+        static constexpr std::size_t bit_size() noexcept
+        {
+            return Bits;
+        }
+
+        /// \returns The base of the exponent.
+        static constexpr double base() noexcept
+        {
+            return double(Base::num) / double(Base::den);
+        }
+
+        /// \returns The count represented by the exponent.
+        static double estimate(object_type exponent) noexcept
+        {
+            return (std::pow(base(), double(exponent)) - 1.) / (base() - 1.);
+        }
+
+        /// \returns The maximal exponent, after that the counter saturates.
+        static constexpr object_type max_exponent() noexcept
+        {
+            return object_type(detail::all_bits_set(Bits));
+        }
+
+    private:
+        static constexpr bool is_base_two = Base::num == 2 * Base::den;
+
+        static constexpr std::size_t table_size = detail::all_bits_set(Bits) + 1u < 4096u
+                                                      ? std::size_t(detail::all_bits_set(Bits)) + 1u
+                                                      : 4096u;
+
+        struct threshold_table
+        {
+            std::uint64_t values[table_size];
+
+            threshold_table() noexcept
+            {
+                for (auto exponent = std::size_t(0); exponent != table_size; ++exponent)
+                    values[exponent]
+                        = approx_detail::to_threshold(std::pow(base(), -double(exponent)));
+            }
+        };
+
+        // the probability of incrementing the exponent as fraction of 2^64, exponent > 0
+        static std::uint64_t threshold(object_type exponent) noexcept
+        {
+            if (is_base_two)
+                return exponent < 64u ? std::uint64_t(1) << (64u - exponent) : 0u;
+            else if (exponent < table_size)
+            {
+                static const threshold_table table;
+                return table.values[exponent];
+            }
+            else
+                return approx_detail::to_threshold(std::pow(base(), -double(exponent)));
+        }
+
+    public:
+        template <class BitView>
+        class proxy
+        {
+        public:
+            /// \returns The exponent.
+            operator object_type() const noexcept
+            {
+                return get();
+            }
+
+            /// \effects Sets the exponent.
+            const proxy& operator=(object_type exponent) const noexcept
+            {
+                DEBUG_ASSERT(exponent <= max_exponent(), detail::precondition_handler{},
+                             "overflow in tiny approx counter");
+                view_.put(exponent);
+                return *this;
+            }
+
+            /// \returns The estimated count.
+            double estimate() const noexcept
+            {
+                return tiny_approx_counter::estimate(get());
+            }
+
+            /// \effects Counts one event, i.e. increments the exponent with probability
+            /// `Base^-exponent` using the given `UniformRandomBitGenerator`.
+            /// If the exponent is already the maximum, does nothing.
+            /// \returns Whether or not the exponent was incremented.
+            /// \notes It is `noexcept` if invoking the generator is,
+            /// and it uses the output directly if the generator produces 64 bit numbers.
+            template <class Rng>
+            bool increment(Rng& rng) const noexcept(noexcept(rng()))
+            {
+                auto exponent = get();
+                if (exponent == max_exponent())
+                    return false;
+                else if (exponent != 0u
+                         && approx_detail::random_bits(rng) >= threshold(exponent))
+                    return false;
+
+                view_.put(exponent + 1u);
+                return true;
+            }
+
+            /// \effects Same as `increment(thread_local_engine())`.
+            bool increment() const noexcept
+            {
+                return increment(thread_local_engine());
+            }
+
+            /// \effects Resets the count to zero.
+            void reset() const noexcept
+            {
+                view_.put(0u);
+            }
+
+        private:
+            explicit proxy(BitView view) noexcept : view_(view) {}
+
+            object_type get() const noexcept
+            {
+                return static_cast<object_type>(view_.extract());
+            }
+
+            BitView view_;
+
+            friend tiny_type_access;
+        };
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_TINY_APPROX_COUNTER_HPP_INCLUDED
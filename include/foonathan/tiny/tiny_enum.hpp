@@ -12,19 +12,80 @@ namespace foonathan
 {
 namespace tiny
 {
+    /// \exclude
+    namespace detail
+    {
+        // encodes the enum value directly
+        template <class Traits, bool IsSparse = enum_traits_detail::is_sparse<Traits>::value>
+        struct enum_encoding
+        {
+            static_assert(Traits::is_contiguous, "enum must be contiguous or sparse");
+            static_assert(Traits::min() == typename Traits::enum_type(0),
+                          "enum value must start at 0");
+
+            using enum_type = typename Traits::enum_type;
+
+            static constexpr std::uintmax_t max_encoding() noexcept
+            {
+                return static_cast<std::uintmax_t>(Traits::max());
+            }
+
+            static std::uintmax_t encode(enum_type value) noexcept
+            {
+                DEBUG_ASSERT(is_valid_enum_value<Traits>(value), detail::precondition_handler{},
+                             "not a valid enum value");
+                return static_cast<std::uintmax_t>(value);
+            }
+
+            static enum_type decode(std::uintmax_t encoding) noexcept
+            {
+                return static_cast<enum_type>(encoding);
+            }
+        };
+
+        // encodes the index of the enum value
+        template <class Traits>
+        struct enum_encoding<Traits, true>
+        {
+            using enum_type = typename Traits::enum_type;
+
+            static constexpr std::uintmax_t max_encoding() noexcept
+            {
+                return Traits::size() - 1u;
+            }
+
+            static std::uintmax_t encode(enum_type value) noexcept
+            {
+                auto index = Traits::index_of(value);
+                DEBUG_ASSERT(index < Traits::size(), detail::precondition_handler{},
+                             "not a valid enum value");
+                return index;
+            }
+
+            static enum_type decode(std::uintmax_t encoding) noexcept
+            {
+                DEBUG_ASSERT(encoding < Traits::size(), detail::assert_handler{});
+                return Traits::value_at(std::size_t(encoding));
+            }
+        };
+    } // namespace detail
+
     /// A `TinyType` implementation of an enumeration type.
     ///
     /// `EnumOrTraits` is either an enum type or an `enum_traits`-like type.
     /// [lex::traits_of_enum]() is then applied.
     ///
-    /// \requires The enum must be contiguous with the valid enumerators stored in the range `[0,
-    /// Traits::max]`.
+    /// If the traits are sparse, like [tiny::enum_traits_sparse](),
+    /// the index of the value is stored, so only the bits for the number of valid values are
+    /// needed.
+    ///
+    /// \requires The enum must be sparse or contiguous with the valid enumerators stored in the
+    /// range `[0, Traits::max]`.
     template <class EnumOrTraits>
     class tiny_enum
     {
-        using traits = traits_of_enum<EnumOrTraits>;
-        static_assert(traits::is_contiguous, "enum must be contiguous");
-        static_assert(traits::min() == typename traits::enum_type(0), "enum value must start at 0");
+        using traits   = traits_of_enum<EnumOrTraits>;
+        using encoding = detail::enum_encoding<traits>;
 
     public:
         using object_type = typename traits::enum_type;
@@ -34,21 +95,26 @@ namespace tiny
             return enum_bit_size<EnumOrTraits>();
         }
 
+        /// \returns The bit pattern of `Traits::max()` or the index of the last value,
+        /// all bigger bit patterns are unused.
+        static constexpr std::uintmax_t max_encoding() noexcept
+        {
+            return encoding::max_encoding();
+        }
+
         template <class BitView>
         class proxy
         {
         public:
             const proxy& operator=(object_type value) const noexcept
             {
-                DEBUG_ASSERT(is_valid_enum_value<traits>(value), detail::precondition_handler{},
-                             "not a valid enum value");
-                view_.put(static_cast<std::uintmax_t>(value));
+                view_.put(encoding::encode(value));
                 return *this;
             }
 
             operator object_type() const noexcept
             {
-                return static_cast<object_type>(view_.extract());
+                return encoding::decode(view_.extract());
             }
 
         private:
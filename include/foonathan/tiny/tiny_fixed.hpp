@@ -0,0 +1,313 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_TINY_FIXED_HPP_INCLUDED
+#define FOONATHAN_TINY_TINY_FIXED_HPP_INCLUDED
+
+#include <cmath>
+#include <cstdint>
+
+#include <foonathan/tiny/tiny_type.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// How a value is rounded when it can't be represented exactly in a fixed-point number.
+    enum class fixed_rounding
+    {
+        /// Round to the nearest value, ties away from zero.
+        nearest,
+        /// Round toward zero, i.e. truncate.
+        toward_zero,
+        /// Round toward negative infinity.
+        down,
+        /// Round toward positive infinity.
+        up,
+    };
+
+    /// \exclude
+    namespace tiny_fixed_detail
+    {
+        template <fixed_rounding Rounding>
+        struct rounding;
+
+        template <>
+        struct rounding<fixed_rounding::nearest>
+        {
+            template <typename Float>
+            static Float round(Float value) noexcept
+            {
+                return std::round(value);
+            }
+
+            static std::intmax_t adjust(std::intmax_t quotient, std::intmax_t remainder,
+                                        std::intmax_t divisor) noexcept
+            {
+                if (2 * remainder >= divisor)
+                    return quotient + 1;
+                else if (2 * remainder <= -divisor)
+                    return quotient - 1;
+                else
+                    return quotient;
+            }
+        };
+
+        template <>
+        struct rounding<fixed_rounding::toward_zero>
+        {
+            template <typename Float>
+            static Float round(Float value) noexcept
+            {
+                return std::trunc(value);
+            }
+
+            static std::intmax_t adjust(std::intmax_t quotient, std::intmax_t,
+                                        std::intmax_t) noexcept
+            {
+                return quotient;
+            }
+        };
+
+        template <>
+        struct rounding<fixed_rounding::down>
+        {
+            template <typename Float>
+            static Float round(Float value) noexcept
+            {
+                return std::floor(value);
+            }
+
+            static std::intmax_t adjust(std::intmax_t quotient, std::intmax_t remainder,
+                                        std::intmax_t) noexcept
+            {
+                return remainder < 0 ? quotient - 1 : quotient;
+            }
+        };
+
+        template <>
+        struct rounding<fixed_rounding::up>
+        {
+            template <typename Float>
+            static Float round(Float value) noexcept
+            {
+                return std::ceil(value);
+            }
+
+            static std::intmax_t adjust(std::intmax_t quotient, std::intmax_t remainder,
+                                        std::intmax_t) noexcept
+            {
+                return remainder > 0 ? quotient + 1 : quotient;
+            }
+        };
+
+        // raw arithmetic is done in std::intmax_t,
+        // so products of two numbers must not overflow
+        constexpr std::size_t max_bits = 31u;
+
+        template <bool Signed, std::size_t IntBits, std::size_t FracBits, typename Float,
+                  fixed_rounding Rounding>
+        class tiny_fixed_impl
+        {
+            static_assert(std::is_floating_point<Float>::value, "must be a floating point type");
+            static_assert(!Signed || IntBits > 0u, "signed fixed-point number needs a sign bit");
+            static_assert(IntBits + FracBits <= max_bits, "too many bits for fixed-point number");
+
+            using round = rounding<Rounding>;
+
+            static constexpr Float scale() noexcept
+            {
+                return Float(std::intmax_t(1) << FracBits);
+            }
+
+        public:
+            using object_type = Float;
+
+            /// The integer type of the raw value,
+            /// which is the value multiplied by `2^FracBits`.
+            using raw_type = std::intmax_t;
+
+            static constexpr std::size_t bit_size() noexcept
+            {
+                return IntBits + FracBits;
+            }
+
+            /// \returns The minimal raw value.
+            static constexpr raw_type raw_min() noexcept
+            {
+                return Signed ? -(raw_type(1) << (bit_size() - 1u)) : 0;
+            }
+            /// \returns The maximal raw value.
+            static constexpr raw_type raw_max() noexcept
+            {
+                return (raw_type(1) << (Signed ? bit_size() - 1u : bit_size())) - 1;
+            }
+
+            /// \returns The minimal value that can be stored.
+            static constexpr Float min() noexcept
+            {
+                return from_raw(raw_min());
+            }
+            /// \returns The maximal value that can be stored.
+            static constexpr Float max() noexcept
+            {
+                return from_raw(raw_max());
+            }
+            /// \returns The difference between two consecutive values, `2^-FracBits`.
+            static constexpr Float epsilon() noexcept
+            {
+                return from_raw(1);
+            }
+
+            /// \returns The value of the raw value.
+            static constexpr Float from_raw(raw_type raw) noexcept
+            {
+                return Float(raw) / scale();
+            }
+
+            /// \returns The raw value of the given value, rounded as specified.
+            /// \notes The result might not be in the range `[raw_min(), raw_max()]`.
+            static raw_type to_raw(Float value) noexcept
+            {
+                auto scaled = round::round(value * scale());
+                DEBUG_ASSERT(std::fabs(scaled) <= Float(raw_type(1) << max_bits),
+                             detail::precondition_handler{},
+                             "value too big for fixed-point number");
+                return raw_type(scaled);
+            }
+
+            /// \returns The product of two raw values, rounded as specified.
+            static raw_type multiply_raw(raw_type lhs, raw_type rhs) noexcept
+            {
+                auto product  = lhs * rhs;
+                auto divisor  = raw_type(1) << FracBits;
+                auto quotient = product / divisor;
+                return round::adjust(quotient, product - quotient * divisor, divisor);
+            }
+
+            template <class BitView>
+            class proxy
+            {
+            public:
+                operator object_type() const noexcept
+                {
+                    return from_raw(raw());
+                }
+
+                /// \effects Stores the value rounded to the nearest fixed-point number as specified
+                /// by the rounding mode.
+                /// \requires The rounded value must be in the range `[min(), max()]`.
+                const proxy& operator=(object_type value) const noexcept
+                {
+                    set_raw(to_raw(value));
+                    return *this;
+                }
+
+                /// \returns The raw value.
+                raw_type raw() const noexcept
+                {
+                    auto bits = view_.extract();
+                    if (Signed && (bits >> (bit_size() - 1u)) != 0u)
+                        // negative value, undo the two's complement
+                        return -raw_type(detail::all_bits_set(bit_size()) - bits) - 1;
+                    else
+                        return raw_type(bits);
+                }
+
+                /// \effects Sets the raw value.
+                /// \requires `raw_min() <= raw && raw <= raw_max()`.
+                void set_raw(raw_type raw) const noexcept
+                {
+                    DEBUG_ASSERT(raw_min() <= raw && raw <= raw_max(),
+                                 detail::precondition_handler{}, "overflow in tiny fixed");
+                    view_.put(static_cast<std::uintmax_t>(raw));
+                }
+
+                //=== arithmetic with fixed-point numbers ===//
+                /// \effects Adds the raw values, so it is exact.
+                template <class OtherBitView>
+                const proxy& operator+=(const proxy<OtherBitView>& other) const noexcept
+                {
+                    set_raw(raw() + other.raw());
+                    return *this;
+                }
+                /// \effects Subtracts the raw values, so it is exact.
+                template <class OtherBitView>
+                const proxy& operator-=(const proxy<OtherBitView>& other) const noexcept
+                {
+                    set_raw(raw() - other.raw());
+                    return *this;
+                }
+                /// \effects Multiplies the raw values and rescales the product,
+                /// which is rounded as specified.
+                template <class OtherBitView>
+                const proxy& operator*=(const proxy<OtherBitView>& other) const noexcept
+                {
+                    set_raw(multiply_raw(raw(), other.raw()));
+                    return *this;
+                }
+
+                //=== arithmetic with floating points ===//
+                /// \effects Converts `value` into a fixed-point number with the same scale,
+                /// then adds that.
+                const proxy& operator+=(object_type value) const noexcept
+                {
+                    set_raw(raw() + to_raw(value));
+                    return *this;
+                }
+                /// \effects Converts `value` into a fixed-point number with the same scale,
+                /// then subtracts that.
+                const proxy& operator-=(object_type value) const noexcept
+                {
+                    set_raw(raw() - to_raw(value));
+                    return *this;
+                }
+                /// \effects Converts `value` into a fixed-point number with the same scale,
+                /// then multiplies with that.
+                /// \notes `value` does not need to be in the range `[min(), max()]`.
+                const proxy& operator*=(object_type value) const noexcept
+                {
+                    set_raw(multiply_raw(raw(), to_raw(value)));
+                    return *this;
+                }
+
+            private:
+                explicit proxy(BitView view) noexcept : view_(view) {}
+
+                BitView view_;
+
+                friend tiny_type_access;
+            };
+        };
+    } // namespace tiny_fixed_detail
+
+    /// A `TinyType` implementation of an unsigned fixed-point number.
+    ///
+    /// It has `IntBits` bits before the binary point and `FracBits` bits after it,
+    /// so it stores the values `[0, 2^IntBits)` in steps of `2^-FracBits`.
+    /// The object type is `Float` and the assignment rounds the value as specified by `Rounding`.
+    /// Overflow is checked in debug mode whenever the number is stored.
+    ///
+    /// The proxy provides access to the raw value, which is the value multiplied by
+    /// `2^FracBits`, and exact arithmetic on it.
+    /// \requires `IntBits + FracBits` must be at most 31.
+    template <std::size_t IntBits, std::size_t FracBits, typename Float = double,
+              fixed_rounding Rounding = fixed_rounding::nearest>
+    using tiny_ufixed
+        = tiny_fixed_detail::tiny_fixed_impl<false, IntBits, FracBits, Float, Rounding>;
+
+    /// A `TinyType` implementation of a signed fixed-point number.
+    ///
+    /// It has `IntBits` bits before the binary point, including the sign bit,
+    /// and `FracBits` bits after it, so it stores the values `[-2^(IntBits - 1), 2^(IntBits - 1))`
+    /// in steps of `2^-FracBits` using two's complement.
+    /// Otherwise, it is the same as [tiny::tiny_ufixed]().
+    /// \requires `IntBits` must be at least one and `IntBits + FracBits` must be at most 31.
+    template <std::size_t IntBits, std::size_t FracBits, typename Float = double,
+              fixed_rounding Rounding = fixed_rounding::nearest>
+    using tiny_fixed = tiny_fixed_detail::tiny_fixed_impl<true, IntBits, FracBits, Float, Rounding>;
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_TINY_FIXED_HPP_INCLUDED
@@ -0,0 +1,277 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_TINY_FLOAT_HPP_INCLUDED
+#define FOONATHAN_TINY_TINY_FLOAT_HPP_INCLUDED
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+#include <foonathan/tiny/detail/select_integer.hpp>
+#include <foonathan/tiny/tiny_type.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// How a [tiny::tiny_float]() encodes the special values.
+    enum class float_layout
+    {
+        /// Like IEEE 754: an all-one exponent denotes infinity and NaN.
+        ieee,
+        /// There is no infinity, only the encoding with all exponent and mantissa bits set is
+        /// NaN, so the all-one exponent stores normal numbers otherwise.
+        /// This is the "FN" layout of the OCP 8-bit floating point formats,
+        /// e.g. `tiny_float<4, 3, float_layout::finite>` is E4M3FN with a maximum of 448.
+        finite,
+    };
+
+    /// \exclude
+    namespace tiny_float_detail
+    {
+        static_assert(std::numeric_limits<float>::is_iec559
+                          && sizeof(float) == sizeof(std::uint32_t),
+                      "tiny_float requires IEEE 754 single precision floats");
+
+        constexpr std::uint32_t float_sign_bit  = 0x80000000u;
+        constexpr std::uint32_t float_inf_bits  = 0x7F800000u;
+        constexpr std::uint32_t float_mant_mask = 0x007FFFFFu;
+        constexpr std::size_t   float_mant_bits = 23u;
+        constexpr int           float_bias      = 127;
+
+        inline std::uint32_t to_bits(float value) noexcept
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return bits;
+        }
+
+        inline float from_bits(std::uint32_t bits) noexcept
+        {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        // the bits of 2^exp, exp must be in the range [-149, 127]
+        inline std::uint32_t pow2_bits(int exp) noexcept
+        {
+            if (exp >= 1 - float_bias)
+                return std::uint32_t(exp + float_bias) << float_mant_bits;
+            else
+                // subnormal float
+                return std::uint32_t(1) << unsigned(exp + float_bias - 1 + int(float_mant_bits));
+        }
+
+        // shifts the value to the right, rounding to nearest, ties to even
+        inline std::uint32_t shift_round(std::uint32_t value, unsigned shift) noexcept
+        {
+            if (shift == 0u)
+                return value;
+            else if (shift > float_mant_bits + 1u)
+                // value < 2^24 is less than half
+                return 0u;
+
+            auto result    = value >> shift;
+            auto remainder = value & ((std::uint32_t(1) << shift) - 1u);
+            auto half      = std::uint32_t(1) << (shift - 1u);
+            if (remainder > half || (remainder == half && (result & 1u) != 0u))
+                ++result;
+            return result;
+        }
+    } // namespace tiny_float_detail
+
+    /// A `TinyType` implementation of a small binary floating point number.
+    ///
+    /// It has a sign bit, `ExpBits` exponent bits and `MantBits` mantissa bits and uses the same
+    /// layout as IEEE 754: the exponent has a bias of `2^(ExpBits - 1) - 1`, an all-zero exponent
+    /// denotes subnormal numbers and, with the default [tiny::float_layout::ieee](),
+    /// an all-one exponent infinity and NaN.
+    /// So `tiny_float<5, 10>` is a half precision float, `tiny_float<8, 7>` has the range of
+    /// bfloat16 and `tiny_float<5, 2>` is the OCP E5M2 format.
+    /// The OCP E4M3 format has no infinities and needs [tiny::float_layout::finite]().
+    ///
+    /// The object type is `float`.
+    /// Conversion from `float` rounds to nearest with ties to even,
+    /// but finite values that are too big saturate to the largest finite number instead of
+    /// becoming infinity. NaN is preserved and so is infinity for the IEEE layout,
+    /// the finite layout saturates it as well.
+    /// Conversion to `float` is exact.
+    /// \requires `ExpBits` must be in the range `[2, 8]`, or `[2, 7]` for the finite layout,
+    /// and `MantBits` in the range `[1, 23]`.
+    template <std::size_t ExpBits, std::size_t MantBits, float_layout Layout = float_layout::ieee>
+    class tiny_float
+    {
+        static_assert(ExpBits >= 2u && ExpBits <= 8u, "invalid number of exponent bits");
+        static_assert(Layout == float_layout::ieee || ExpBits <= 7u,
+                      "the biggest numbers of the finite layout are not representable as float");
+        static_assert(MantBits >= 1u && MantBits <= tiny_float_detail::float_mant_bits,
+                      "invalid number of mantissa bits");
+
+        static constexpr bool          finite    = Layout == float_layout::finite;
+        static constexpr std::uint32_t exp_mask  = (std::uint32_t(1) << ExpBits) - 1u;
+        static constexpr std::uint32_t mant_mask = (std::uint32_t(1) << MantBits) - 1u;
+        static constexpr std::uint32_t inf_bits  = exp_mask << MantBits;
+        static constexpr std::uint32_t sign_bit  = std::uint32_t(1) << (ExpBits + MantBits);
+        static constexpr int           bias      = (1 << (ExpBits - 1u)) - 1;
+        // exponent of the smallest normal number
+        static constexpr int min_exp = 1 - bias;
+        // the absolute encoding of the quiet NaN
+        static constexpr std::uint32_t nan_bits
+            = finite ? inf_bits | mant_mask : inf_bits | (std::uint32_t(1) << (MantBits - 1u));
+        // the first absolute encoding that isn't finite, the one before is the biggest number
+        static constexpr std::uint32_t overflow_bits = finite ? nan_bits : inf_bits;
+
+    public:
+        using object_type = float;
+
+        /// The integer type of the encoding.
+        using encoding_type = detail::uint_least_n_t<1u + ExpBits + MantBits>;
+
+        static constexpr std::size_t bit_size() noexcept
+        {
+            return 1u + ExpBits + MantBits;
+        }
+
+        /// \returns The encoding of the value, rounded as specified.
+        static encoding_type encode(float value) noexcept
+        {
+            namespace fd = tiny_float_detail;
+
+            auto bits = fd::to_bits(value);
+            auto sign = (bits & fd::float_sign_bit) != 0u ? sign_bit : 0u;
+            auto abs  = bits & ~fd::float_sign_bit;
+            if (abs > fd::float_inf_bits)
+                // quiet NaN
+                return encoding_type(sign | nan_bits);
+            else if (abs == fd::float_inf_bits)
+                // infinity, or the biggest number if there is none
+                return encoding_type(sign | (finite ? overflow_bits - 1u : inf_bits));
+
+            // abs is significand * 2^(exp - bias - mant_bits)
+            auto exp         = int(abs >> fd::float_mant_bits);
+            auto significand = abs & fd::float_mant_mask;
+            if (exp == 0)
+                exp = 1;
+            else
+                significand |= fd::float_mant_mask + 1u;
+
+            // the exponent of the result, subnormal floats are always subnormal here as well
+            auto result_exp = exp - fd::float_bias < min_exp ? min_exp : exp - fd::float_bias;
+            // the value of the last mantissa bit of the result is 2^(result_exp - MantBits),
+            // this is always at least the value of the last mantissa bit of the float
+            auto shift = unsigned(result_exp - int(MantBits) - (exp - fd::float_bias)
+                                  + int(fd::float_mant_bits));
+            auto rounded = fd::shift_round(significand, shift);
+
+            // the implicit bit of rounded adds one to the exponent of normal numbers,
+            // and rounding up carries into the exponent as well
+            auto result = (std::uint32_t(result_exp - min_exp) << MantBits) + rounded;
+            if (result >= overflow_bits)
+                // saturate
+                result = overflow_bits - 1u;
+            return encoding_type(sign | result);
+        }
+
+        /// \returns The value of the encoding.
+        static float decode(encoding_type encoding) noexcept
+        {
+            namespace fd = tiny_float_detail;
+
+            auto sign = (encoding & sign_bit) != 0u ? fd::float_sign_bit : 0u;
+            auto exp  = (std::uint32_t(encoding) >> MantBits) & exp_mask;
+            auto mant = std::uint32_t(encoding) & mant_mask;
+            if (finite && (std::uint32_t(encoding) & ~sign_bit) == nan_bits)
+                // the only NaN
+                return fd::from_bits(sign | fd::float_inf_bits | (fd::float_mant_mask + 1u) / 2u);
+            else if (!finite && exp == exp_mask)
+                // infinity or NaN, keep the payload
+                return fd::from_bits(sign | fd::float_inf_bits
+                                     | (mant << (fd::float_mant_bits - MantBits)));
+            else if (exp == 0u)
+            {
+                // subnormal, mant * 2^(min_exp - MantBits) is exact
+                auto abs = float(mant) * fd::from_bits(fd::pow2_bits(min_exp - int(MantBits)));
+                return fd::from_bits(sign | fd::to_bits(abs));
+            }
+            else
+                return fd::from_bits(sign
+                                     | std::uint32_t(int(exp) - bias + fd::float_bias)
+                                           << fd::float_mant_bits
+                                     | mant << (fd::float_mant_bits - MantBits));
+        }
+
+        /// \effects Encodes the `size` values starting at `first` and writes the encodings to
+        /// `out`.
+        /// \notes The conversion is branch-light integer arithmetic without dependencies between
+        /// elements, so the loop can be vectorized by the compiler.
+        static void encode(const float* first, std::size_t size, encoding_type* out) noexcept
+        {
+            for (std::size_t i = 0u; i != size; ++i)
+                out[i] = encode(first[i]);
+        }
+
+        /// \effects Decodes the `size` encodings starting at `first` and writes the values to
+        /// `out`.
+        /// \notes The conversion is branch-light integer arithmetic without dependencies between
+        /// elements, so the loop can be vectorized by the compiler.
+        static void decode(const encoding_type* first, std::size_t size, float* out) noexcept
+        {
+            for (std::size_t i = 0u; i != size; ++i)
+                out[i] = decode(first[i]);
+        }
+
+        /// \returns The largest finite value.
+        static float max() noexcept
+        {
+            return decode(encoding_type(overflow_bits - 1u));
+        }
+
+        /// \returns The smallest positive normal value.
+        static float min() noexcept
+        {
+            return decode(encoding_type(mant_mask + 1u));
+        }
+
+        /// \returns The smallest positive subnormal value.
+        static float denorm_min() noexcept
+        {
+            return decode(encoding_type(1u));
+        }
+
+        template <class BitView>
+        class proxy
+        {
+        public:
+            operator float() const noexcept
+            {
+                return decode(encoding_type(view_.extract()));
+            }
+
+            /// \effects Stores the value rounded as specified.
+            const proxy& operator=(float value) const noexcept
+            {
+                view_.put(encode(value));
+                return *this;
+            }
+
+            /// \returns The encoding.
+            encoding_type encoding() const noexcept
+            {
+                return encoding_type(view_.extract());
+            }
+
+        private:
+            explicit proxy(BitView view) noexcept : view_(view) {}
+
+            BitView view_;
+
+            friend tiny_type_access;
+        };
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_TINY_FLOAT_HPP_INCLUDED
@@ -244,7 +244,7 @@ namespace tiny
         constexpr std::size_t bits_for() noexcept
         {
             static_assert(Min <= Max, "invalid range");
-            return detail::ilog2_ceil(static_cast<std::uintmax_t>(Max - Min));
+            return detail::ilog2_ceil(static_cast<std::uintmax_t>(Max - Min) + 1u);
         }
     } // namespace tiny_int_detail
 
@@ -269,6 +269,13 @@ namespace tiny
             return tiny_int_detail::bits_for<Min, Max>();
         }
 
+        /// \returns The bit pattern of `Max`,
+        /// all bigger bit patterns are unused.
+        static constexpr std::uintmax_t max_encoding() noexcept
+        {
+            return static_cast<std::uintmax_t>(Max - Min);
+        }
+
         template <class BitView>
         class proxy
         {
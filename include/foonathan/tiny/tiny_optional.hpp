@@ -0,0 +1,96 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_TINY_OPTIONAL_HPP_INCLUDED
+#define FOONATHAN_TINY_TINY_OPTIONAL_HPP_INCLUDED
+
+#include <foonathan/tiny/tiny_type.hpp>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// A `TinyType` implementation of an optional `TinyType`.
+    ///
+    /// It uses an unused encoding of the `TinyType` to mark the empty state,
+    /// so it has the same size in bits.
+    /// The all bits zero value corresponds to the empty optional,
+    /// a value is stored as its encoding plus one.
+    ///
+    /// \requires `TinyType` must have an unused encoding,
+    /// i.e. [tiny::tiny_max_encoding]() must not have all bits set.
+    template <class TinyType>
+    class tiny_optional
+    {
+        static_assert(is_tiny_type<TinyType>::value, "must be a tiny type");
+        static_assert(tiny_max_encoding<TinyType>() < detail::all_bits_set(TinyType::bit_size()),
+                      "TinyType doesn't have an unused encoding");
+
+    public:
+        using object_type = typename TinyType::object_type;
+
+        static constexpr std::size_t bit_size() noexcept
+        {
+            return TinyType::bit_size();
+        }
+
+        /// \returns The maximal encoding of `TinyType` plus one,
+        /// so optionals can be nested as long as there are unused encodings.
+        static constexpr std::uintmax_t max_encoding() noexcept
+        {
+            return tiny_max_encoding<TinyType>() + 1u;
+        }
+
+        template <class BitView>
+        class proxy
+        {
+        public:
+            /// \returns Whether or not the optional stores a value.
+            bool has_value() const noexcept
+            {
+                return view_.extract() != 0u;
+            }
+
+            /// \returns The stored value.
+            /// \requires `has_value() == true`.
+            object_type value() const noexcept
+            {
+                DEBUG_ASSERT(has_value(), detail::precondition_handler{}, "optional is empty");
+                auto encoding = view_.extract() - 1u;
+                return make_tiny_proxy<TinyType>(make_bit_view<0, bit_size()>(encoding));
+            }
+
+            /// \effects Same as `value()`.
+            operator object_type() const noexcept
+            {
+                return value();
+            }
+
+            /// \effects Makes the optional empty.
+            void reset() const noexcept
+            {
+                view_.put(0u);
+            }
+
+            /// \effects Stores the given value.
+            const proxy& operator=(object_type obj) const noexcept
+            {
+                std::uintmax_t encoding = 0;
+                make_tiny_proxy<TinyType>(make_bit_view<0, bit_size()>(encoding)) = obj;
+                view_.put(encoding + 1u);
+                return *this;
+            }
+
+        private:
+            explicit proxy(BitView view) noexcept : view_(view) {}
+
+            BitView view_;
+
+            friend tiny_type_access;
+        };
+    };
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_TINY_OPTIONAL_HPP_INCLUDED
@@ -9,6 +9,7 @@
 
 #include <foonathan/tiny/detail/index_sequence.hpp>
 #include <foonathan/tiny/tiny_type.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
 
 namespace foonathan
 {
@@ -226,8 +227,9 @@ namespace tiny
             clear_bits(this->storage_view());
         }
 
-        /// Object constructor.amazon
-        /// \effects Initializes all tiny types from the corresponding object type.
+        /// Object constructor.
+        /// \effects Initializes all tiny types from the corresponding object type
+        /// and sets the spare bits to zero.
         basic_tiny_storage(typename TinyTypes::object_type... objects) noexcept
         : basic_tiny_storage(detail::make_index_sequence<sizeof...(TinyTypes)>{}, objects...)
         {}
@@ -317,6 +319,8 @@ namespace tiny
         basic_tiny_storage(detail::index_sequence<Indices...>,
                            typename TinyTypes::object_type... objects)
         {
+            clear_bits(this->storage_view());
+
             bool for_each[] = {(at<Indices>() = objects, true)..., true};
             (void)for_each;
         }
@@ -358,6 +362,13 @@ namespace tiny
         using basic_tiny_storage<tiny_storage_detail::embedded_storage_policy<TinyTypes...>,
                                  TinyTypes...>::basic_tiny_storage;
     };
+
+    /// Specialization of [tiny::is_trivially_relocatable]() for [tiny::tiny_storage]().
+    ///
+    /// It only stores bits, so it is always trivially relocatable.
+    template <class... TinyTypes>
+    struct is_trivially_relocatable<tiny_storage<TinyTypes...>> : std::true_type
+    {};
 } // namespace tiny
 } // namespace foonathan
 
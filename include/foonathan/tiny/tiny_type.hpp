@@ -22,6 +22,13 @@ namespace tiny
         /// \returns The size of the object in bits.
         static constexpr std::size_t bit_size() noexcept;
 
+        /// \returns The maximal bit pattern that is used to store an object.
+        ///
+        /// This function is optional, if it isn't provided, all bit patterns are assumed to be used.
+        /// The bit patterns in the range `(max_encoding(), 2^bit_size() - 1]` are never created by the proxy,
+        /// so they can be used as tombstones.
+        static constexpr std::uintmax_t max_encoding() noexcept;
+
         /// A proxy for `object_type`.
         ///
         /// `BitView` is a [tiny::bit_view]() viewing the `bit_size()` bits of storage the object occupies.
@@ -82,6 +89,35 @@ namespace tiny
     struct is_tiny_type : decltype(detail::test_tiny_type<T>(0))
     {};
 
+    namespace detail
+    {
+        constexpr std::uintmax_t all_bits_set(std::size_t bit_size) noexcept
+        {
+            return bit_size >= sizeof(std::uintmax_t) * CHAR_BIT
+                       ? std::uintmax_t(-1)
+                       : (std::uintmax_t(1) << bit_size) - 1u;
+        }
+
+        template <typename T>
+        constexpr auto max_encoding_impl(int) noexcept -> decltype(std::uintmax_t(T::max_encoding()))
+        {
+            return T::max_encoding();
+        }
+        template <typename T>
+        constexpr std::uintmax_t max_encoding_impl(short) noexcept
+        {
+            return all_bits_set(T::bit_size());
+        }
+    } // namespace detail
+
+    /// \returns `TinyType::max_encoding()` if it is provided,
+    /// otherwise the bit pattern where all `TinyType::bit_size()` bits are set.
+    template <class TinyType>
+    constexpr std::uintmax_t tiny_max_encoding() noexcept
+    {
+        return detail::max_encoding_impl<TinyType>(0);
+    }
+
     /// A list of tiny types.
     template <class... TinyTypes>
     struct tiny_types
@@ -6,11 +6,15 @@
 #define FOONATHAN_TINY_TOMBSTONE_HPP_INCLUDED
 
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <new>
 
+#include <foonathan/tiny/enum_traits.hpp>
 #include <foonathan/tiny/padding_traits.hpp>
 #include <foonathan/tiny/tiny_int.hpp>
 #include <foonathan/tiny/tiny_storage.hpp>
+#include <foonathan/tiny/trivially_relocatable.hpp>
 
 namespace foonathan
 {
@@ -26,8 +30,8 @@ namespace tiny
             T    object;
 
             storage_type_trivial() noexcept {}
-            storage_type_trivial(const storage_type_trivial&) = delete;
-            storage_type_trivial& operator=(const storage_type_trivial&) = delete;
+            storage_type_trivial(const storage_type_trivial&) = default;
+            storage_type_trivial& operator=(const storage_type_trivial&) = default;
             ~storage_type_trivial() noexcept                             = default;
         };
 
@@ -64,6 +68,7 @@ namespace tiny
         ///
         /// It must be a type that is default constructible,
         /// "trivially" destructible and doesn't need to be copy constructible or assignable.
+        /// If it is trivially copyable, copying it must copy the object or tombstone stored in it.
         ///
         /// \notes The destructor of this type shouldn't actually destroy something.
         /// But it would be reasonable to use a `union` of `T` and some dummy member.
@@ -138,8 +143,8 @@ namespace tiny
             T         object;
 
             dual_storage_type_trivial() noexcept {}
-            dual_storage_type_trivial(const dual_storage_type_trivial&) = delete;
-            dual_storage_type_trivial& operator=(const dual_storage_type_trivial&) = delete;
+            dual_storage_type_trivial(const dual_storage_type_trivial&) = default;
+            dual_storage_type_trivial& operator=(const dual_storage_type_trivial&) = default;
             ~dual_storage_type_trivial() noexcept                                  = default;
         };
 
@@ -162,6 +167,27 @@ namespace tiny
                                       dual_storage_type_non_trivial<T, Tombstone>>::type;
     } // namespace tombstone_detail
 
+    /// \exclude
+    template <typename T>
+    struct is_trivially_relocatable<tombstone_detail::storage_type_trivial<T>>
+    : is_trivially_relocatable<T>
+    {};
+    /// \exclude
+    template <typename T>
+    struct is_trivially_relocatable<tombstone_detail::storage_type_non_trivial<T>>
+    : is_trivially_relocatable<T>
+    {};
+    /// \exclude
+    template <typename T, class Tombstone>
+    struct is_trivially_relocatable<tombstone_detail::dual_storage_type_trivial<T, Tombstone>>
+    : is_trivially_relocatable<T>
+    {};
+    /// \exclude
+    template <typename T, class Tombstone>
+    struct is_trivially_relocatable<tombstone_detail::dual_storage_type_non_trivial<T, Tombstone>>
+    : is_trivially_relocatable<T>
+    {};
+
     /// A tombstone traits implementation of common boilerplate.
     ///
     /// The `TombstoneType` is a trivially copyable, nothrow default constructible type that is
@@ -294,6 +320,86 @@ namespace tiny
         }
     };
 
+    //=== tombstone_traits using a member ===//
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <typename T>
+        struct object_bytes
+        {
+            alignas(T) unsigned char bytes[sizeof(T)];
+        };
+    } // namespace tombstone_detail
+
+    /// A tombstone traits implementation that uses the tombstones of a member.
+    ///
+    /// `Member` is the [tiny::aggregate_member]() created by `FOONATHAN_TINY_MEMBER(T, member)`.
+    /// A tombstone is created in place of that member using its tombstone traits,
+    /// the remaining bytes of the object are left uninitialized.
+    /// \requires The `storage_type` of the member's tombstone traits must be layout compatible
+    /// with the member itself, which is the case for all tombstone traits with tombstones provided
+    /// by the library.
+    template <typename T, class Member>
+    class tombstone_traits_member
+    {
+        using member_traits  = tombstone_traits<typename Member::member_type>;
+        using member_storage = typename member_traits::storage_type;
+
+        static_assert(std::is_same<T, typename Member::object_type>::value,
+                      "Member must be a member of T");
+        static_assert(std::is_standard_layout<T>::value, "T must be standard layout");
+        static_assert(is_layout_compatible<typename Member::member_type, member_storage>::value,
+                      "tombstone storage of member not layout compatible");
+
+        using bytes_type = tombstone_detail::object_bytes<T>;
+
+        static const member_storage& get_member(const bytes_type& bytes) noexcept
+        {
+            return *reinterpret_cast<const member_storage*>(bytes.bytes + Member::offset());
+        }
+
+    public:
+        using object_type = T;
+
+        using storage_type = tombstone_detail::dual_storage_type_for<T, bytes_type>;
+
+        using reference       = T&;
+        using const_reference = const T&;
+
+        static constexpr std::size_t tombstone_count = member_traits::tombstone_count;
+
+        static void create_tombstone(storage_type& storage, std::size_t tombstone_index) noexcept
+        {
+            auto memory = static_cast<void*>(storage.tombstone.bytes + Member::offset());
+            member_traits::create_tombstone(*::new (memory) member_storage, tombstone_index);
+        }
+
+        template <typename... Args>
+        static void create_object(storage_type& storage, Args&&... args)
+        {
+            ::new (static_cast<void*>(&storage.object)) T(static_cast<Args&&>(args)...);
+        }
+
+        static void destroy_object(storage_type& storage) noexcept
+        {
+            storage.object.~T();
+        }
+
+        static std::size_t get_tombstone(const storage_type& storage) noexcept
+        {
+            return member_traits::get_tombstone(get_member(storage.tombstone));
+        }
+
+        static reference get_object(storage_type& storage) noexcept
+        {
+            return storage.object;
+        }
+        static const_reference get_object(const storage_type& storage) noexcept
+        {
+            return storage.object;
+        }
+    };
+
     /// Specialization of the tombstone traits for types with padding bits and that are valid
     /// tombstone types.
     template <typename T>
@@ -305,35 +411,177 @@ namespace tiny
     {};
 
     //=== tombstone traits for tiny types ===//
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <typename UInt>
+        constexpr std::size_t clamp_tombstone_count(UInt count) noexcept
+        {
+            // don't use all bits, so an invalid index always exists
+            return count > std::size_t(-1) / 2u ? std::size_t(-1) / 2u : std::size_t(count);
+        }
+
+        // index is the difference to the first tombstone value,
+        // objects are smaller, so it overflows to a number >= the unclamped tombstone count
+        // only if the integer is bigger than std::size_t we need to check
+        template <typename UInt>
+        constexpr std::size_t to_tombstone_index(UInt index, std::size_t tombstone_count) noexcept
+        {
+            return sizeof(UInt) <= sizeof(std::size_t) || index < tombstone_count
+                       ? std::size_t(index)
+                       : std::size_t(-1);
+        }
+
+        template <class TinyType>
+        struct tiny_type_storage
+        {
+            tiny_storage_type<TinyType::bit_size()> bits;
+        };
+    } // namespace tombstone_detail
+
     /// Specialization of the tombstone traits for tiny types.
+    ///
+    /// The tiny type is stored in the lower bits of whole bytes.
+    /// All bit patterns of those bytes that are bigger than [tiny::tiny_max_encoding]() are
+    /// tombstones, i.e. the unused encodings of the tiny type as well as the remaining bits.
     template <class TinyType>
     struct tombstone_traits<TinyType, typename std::enable_if<is_tiny_type<TinyType>::value>::type>
     {
     private:
-        static_assert(TinyType::bit_size() < CHAR_BIT, "TinyType is not actually tiny");
+        using bits_type = tiny_storage_type<TinyType::bit_size()>;
 
-        using tombstone_type = tiny_unsigned<CHAR_BIT - TinyType::bit_size(), std::size_t>;
+        static constexpr std::size_t total_bits = sizeof(bits_type) * CHAR_BIT;
+        static_assert(total_bits <= sizeof(std::uintmax_t) * CHAR_BIT, "TinyType is not tiny");
+
+        static constexpr std::uintmax_t max_encoding = tiny_max_encoding<TinyType>();
 
     public:
         using object_type = typename TinyType::object_type;
 
-        using storage_type = tiny_storage<TinyType, tombstone_type>;
+        using storage_type = tombstone_detail::tiny_type_storage<TinyType>;
 
-        using reference       = decltype(std::declval<storage_type&>().template at<0>());
-        using const_reference = decltype(std::declval<const storage_type&>().template at<0>());
+        using reference = decltype(make_tiny_proxy<TinyType>(
+            make_bit_view<0, TinyType::bit_size()>(std::declval<bits_type&>())));
+        using const_reference = decltype(make_tiny_proxy<TinyType>(
+            make_bit_view<0, TinyType::bit_size()>(std::declval<const bits_type&>())));
 
-        static constexpr std::size_t tombstone_count = (1ull << tombstone_type::bit_size()) - 1u;
+        static constexpr std::size_t tombstone_count
+            = tombstone_detail::clamp_tombstone_count(detail::all_bits_set(total_bits)
+                                                      - max_encoding);
 
         static void create_tombstone(storage_type& storage, std::size_t tombstone_index) noexcept
         {
-            storage.template at<1>() = tombstone_index + 1;
+            make_bit_view<0, last_bit>(storage.bits).put(max_encoding + 1u + tombstone_index);
         }
 
         template <typename... Args>
         static void create_object(storage_type& storage, Args&&... args)
         {
-            storage.template at<0>() = object_type(static_cast<Args&&>(args)...);
-            storage.template at<1>() = 0;
+            make_bit_view<0, last_bit>(storage.bits).put(0);
+            get_object(storage) = object_type(static_cast<Args&&>(args)...);
+        }
+
+        static void destroy_object(storage_type&) noexcept {}
+
+        static std::size_t get_tombstone(const storage_type& storage) noexcept
+        {
+            auto encoding = make_bit_view<0, last_bit>(storage.bits).extract();
+            return tombstone_detail::to_tombstone_index(std::uintmax_t(encoding - max_encoding
+                                                                       - 1u),
+                                                        tombstone_count);
+        }
+
+        static reference get_object(storage_type& storage) noexcept
+        {
+            return make_tiny_proxy<TinyType>(make_bit_view<0, TinyType::bit_size()>(storage.bits));
+        }
+        static const_reference get_object(const storage_type& storage) noexcept
+        {
+            return make_tiny_proxy<TinyType>(make_bit_view<0, TinyType::bit_size()>(storage.bits));
+        }
+    };
+
+    //=== tombstone traits for tiny storages ===//
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <class Policy, class... TinyTypes>
+        std::true_type is_tiny_storage_impl(const basic_tiny_storage<Policy, TinyTypes...>*);
+        std::false_type is_tiny_storage_impl(const void*);
+
+        template <typename T>
+        struct is_tiny_storage : decltype(is_tiny_storage_impl(std::declval<T*>()))
+        {};
+
+        template <class TinyStorage>
+        constexpr std::size_t spare_bit_size() noexcept
+        {
+            return decltype(std::declval<const TinyStorage&>().spare_bits())::size();
+        }
+
+        template <class TinyStorage, bool IsTinyStorage = is_tiny_storage<TinyStorage>::value>
+        struct has_spare_bits
+        : std::integral_constant<bool, std::is_trivially_destructible<TinyStorage>::value
+                                           && (spare_bit_size<TinyStorage>() > 0u)>
+        {};
+
+        template <class TinyStorage>
+        struct has_spare_bits<TinyStorage, false> : std::false_type
+        {};
+    } // namespace tombstone_detail
+
+    /// Specialization of the tombstone traits for types derived from [tiny::basic_tiny_storage]()
+    /// that have spare bits.
+    ///
+    /// This includes [tiny::tiny_storage](), [tiny::pointer_tiny_storage]() if it doesn't use all
+    /// alignment bits, and [tiny::padding_tiny_storage]() if it doesn't use all padding bits.
+    /// A tombstone is a default constructed object whose spare bits store the index plus one.
+    /// \requires The type must be trivially destructible and the spare bits of an object must
+    /// not be modified.
+    template <class TinyStorage>
+    struct tombstone_traits<
+        TinyStorage,
+        typename std::enable_if<tombstone_detail::has_spare_bits<TinyStorage>::value>::type>
+    {
+    private:
+        static constexpr std::size_t tombstone_bits
+            = tombstone_detail::spare_bit_size<TinyStorage>() > sizeof(std::size_t) * CHAR_BIT - 1
+                  ? sizeof(std::size_t) * CHAR_BIT - 1
+                  : tombstone_detail::spare_bit_size<TinyStorage>();
+
+        static auto tombstone_view(TinyStorage& obj) noexcept
+            -> decltype(obj.spare_bits().template subview<0, tombstone_bits>())
+        {
+            return obj.spare_bits().template subview<0, tombstone_bits>();
+        }
+        static auto tombstone_view(const TinyStorage& obj) noexcept
+            -> decltype(obj.spare_bits().template subview<0, tombstone_bits>())
+        {
+            return obj.spare_bits().template subview<0, tombstone_bits>();
+        }
+
+    public:
+        using object_type = TinyStorage;
+
+        using storage_type = tombstone_detail::storage_type_for<TinyStorage>;
+
+        using reference       = TinyStorage&;
+        using const_reference = const TinyStorage&;
+
+        // - 1 because all zero is the actual object
+        static constexpr std::size_t tombstone_count = (1ull << tombstone_bits) - 1;
+
+        static void create_tombstone(storage_type& storage, std::size_t tombstone_index) noexcept
+        {
+            ::new (static_cast<void*>(&storage.object)) TinyStorage();
+            tombstone_view(storage.object).put(tombstone_index + 1);
+        }
+
+        template <typename... Args>
+        static void create_object(storage_type& storage, Args&&... args)
+        {
+            ::new (static_cast<void*>(&storage.object)) TinyStorage(static_cast<Args&&>(args)...);
+            tombstone_view(storage.object).put(0);
         }
 
         static void destroy_object(storage_type&) noexcept {}
@@ -342,18 +590,16 @@ namespace tiny
         {
             // if data == 0: no tombstone
             // else: data - 1 is index
-            // we can unconditionally subtract one, if zero, it overflows and we have an invalid
-            // index
-            return storage.template at<1>() - 1;
+            return static_cast<std::size_t>(tombstone_view(storage.object).extract() - 1);
         }
 
         static reference get_object(storage_type& storage) noexcept
         {
-            return storage.template at<0>();
+            return storage.object;
         }
         static const_reference get_object(const storage_type& storage) noexcept
         {
-            return storage.template at<0>();
+            return storage.object;
         }
     };
 
@@ -402,6 +648,146 @@ namespace tiny
         }
     };
 
+    //=== tombstone_traits for enums ===//
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <typename Enum>
+        using enum_unsigned =
+            typename std::make_unsigned<typename std::underlying_type<Enum>::type>::type;
+
+        template <typename Enum>
+        constexpr enum_unsigned<Enum> enum_tombstone_count() noexcept
+        {
+            using underlying = typename std::underlying_type<Enum>::type;
+            return enum_unsigned<Enum>(std::numeric_limits<underlying>::max())
+                   - enum_unsigned<Enum>(underlying(enum_traits<Enum>::max()));
+        }
+
+        template <typename Enum, bool IsEnum = std::is_enum<Enum>::value>
+        struct has_enum_tombstones
+        : std::integral_constant<bool, enum_traits<Enum>::is_specialized
+                                           && enum_traits<Enum>::is_contiguous
+                                           && (enum_tombstone_count<Enum>() > 0u)>
+        {};
+
+        template <typename Enum>
+        struct has_enum_tombstones<Enum, false> : std::false_type
+        {};
+    } // namespace tombstone_detail
+
+    /// Specialization of the tombstone traits for enums with specialized and contiguous
+    /// [tiny::enum_traits]().
+    ///
+    /// It uses the values in the range `(max, std::numeric_limits<underlying>::max()]` as
+    /// tombstones. They are only ever stored as the underlying type, never as the enum itself.
+    template <typename Enum>
+    struct tombstone_traits<
+        Enum, typename std::enable_if<tombstone_detail::has_enum_tombstones<Enum>::value>::type>
+    : tombstone_traits_simple<Enum, typename std::underlying_type<Enum>::type>
+    {
+    private:
+        using underlying = typename std::underlying_type<Enum>::type;
+        using uint_t     = tombstone_detail::enum_unsigned<Enum>;
+
+        static constexpr uint_t first_tombstone = uint_t(underlying(enum_traits<Enum>::max())) + 1u;
+
+    public:
+        static constexpr std::size_t tombstone_count
+            = tombstone_detail::clamp_tombstone_count(tombstone_detail::enum_tombstone_count<Enum>());
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            ::new (memory) underlying(static_cast<underlying>(first_tombstone + uint_t(index)));
+        }
+
+        static std::size_t get_tombstone_impl(underlying value) noexcept
+        {
+            return tombstone_detail::to_tombstone_index(uint_t(uint_t(value) - first_tombstone),
+                                                        tombstone_count);
+        }
+    };
+
+    //=== tombstone_traits for floating points ===//
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <typename Float>
+        struct float_tombstones;
+
+        template <>
+        struct float_tombstones<float>
+        {
+            using bits_type = std::uint32_t;
+
+            // negative infinity, any non-zero payload makes it a negative NaN
+            static constexpr bits_type prefix = 0xFF800000u;
+            // below the quiet bit (22) and the bit set by signaling_NaN() (21)
+            static constexpr std::size_t payload_bits = 21u;
+        };
+
+        template <>
+        struct float_tombstones<double>
+        {
+            using bits_type = std::uint64_t;
+
+            static constexpr bits_type   prefix       = 0xFFF0000000000000u;
+            static constexpr std::size_t payload_bits = 50u;
+        };
+
+        template <typename Float>
+        struct has_float_tombstones : std::false_type
+        {};
+
+        template <>
+        struct has_float_tombstones<float>
+        : std::integral_constant<bool, std::numeric_limits<float>::is_iec559
+                                           && sizeof(float) == sizeof(std::uint32_t)>
+        {};
+
+        template <>
+        struct has_float_tombstones<double>
+        : std::integral_constant<bool, std::numeric_limits<double>::is_iec559
+                                           && sizeof(double) == sizeof(std::uint64_t)>
+        {};
+    } // namespace tombstone_detail
+
+    /// Specialization of the tombstone traits for `float` and `double`.
+    ///
+    /// The tombstones are signalling NaNs with the sign bit set and a payload that doesn't use the
+    /// two most significant bits of the mantissa.
+    /// Those are never produced by arithmetic, which only creates quiet NaNs,
+    /// and they are also different from `-std::numeric_limits<Float>::signaling_NaN()`.
+    /// \requires The floating point type uses IEEE 754 and no object with such a bit pattern is
+    /// stored.
+    template <typename Float>
+    struct tombstone_traits<
+        Float, typename std::enable_if<tombstone_detail::has_float_tombstones<Float>::value>::type>
+    : tombstone_traits_simple<Float, typename tombstone_detail::float_tombstones<Float>::bits_type>
+    {
+    private:
+        using info      = tombstone_detail::float_tombstones<Float>;
+        using bits_type = typename info::bits_type;
+
+    public:
+        // payload zero is the infinity
+        static constexpr std::size_t tombstone_count
+            = tombstone_detail::clamp_tombstone_count((bits_type(1) << info::payload_bits) - 1u);
+
+        static void create_tombstone_impl(void* memory, std::size_t index) noexcept
+        {
+            ::new (memory) bits_type(info::prefix | bits_type(index + 1u));
+        }
+
+        static std::size_t get_tombstone_impl(bits_type bits) noexcept
+        {
+            // only the payload bits differ for tombstones, so the xor yields index + 1,
+            // for every other value it is zero (negative infinity) or has bigger bits set
+            return tombstone_detail::to_tombstone_index(bits_type((bits ^ info::prefix) - 1u),
+                                                        tombstone_count);
+        }
+    };
+
     //=== tombstone_traits for pointers ===//
     /// \exclude
     template <typename T, std::size_t Alignment>
@@ -447,7 +833,7 @@ namespace tiny
             }
             static const_reference get_object(const storage_type& storage) noexcept
             {
-                return reinterpret_cast<reference>(storage);
+                return reinterpret_cast<const_reference>(storage);
             }
         };
 
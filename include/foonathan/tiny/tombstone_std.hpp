@@ -0,0 +1,270 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_TOMBSTONE_STD_HPP_INCLUDED
+#define FOONATHAN_TINY_TOMBSTONE_STD_HPP_INCLUDED
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L
+#    include <string_view>
+#endif
+
+#include <foonathan/tiny/tombstone.hpp>
+
+/// Whether or not the tombstone traits for standard library types are available.
+///
+/// They rely on the object representation of the standard library types,
+/// so they are only provided for libstdc++ and libc++.
+#ifndef FOONATHAN_TINY_STD_TOMBSTONES
+#    if defined(__GLIBCXX__) || defined(_LIBCPP_VERSION)
+#        define FOONATHAN_TINY_STD_TOMBSTONES 1
+#    else
+#        define FOONATHAN_TINY_STD_TOMBSTONES 0
+#    endif
+#endif
+
+#if FOONATHAN_TINY_STD_TOMBSTONES
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// \exclude
+    namespace tombstone_detail
+    {
+        template <typename T>
+        struct object_words
+        {
+            static constexpr std::size_t size = sizeof(T) / sizeof(std::uintptr_t);
+
+            alignas(T) std::uintptr_t words[size];
+        };
+
+        // Layout must provide:
+        // * static constexpr std::size_t tombstone_count
+        // * static void create_tombstone(std::uintptr_t* words, std::size_t index)
+        // * static std::size_t get_tombstone(const std::uintptr_t* words)
+        // where words is the object representation of T as an array of pointer sized integers
+        template <typename T, class Layout>
+        class tombstone_traits_words
+        {
+            static_assert(sizeof(T) % sizeof(std::uintptr_t) == 0u
+                              && alignof(T) == alignof(std::uintptr_t),
+                          "unexpected layout of standard library type");
+
+            using words_type = object_words<T>;
+
+        public:
+            using object_type  = T;
+            using storage_type = dual_storage_type_for<T, words_type>;
+
+            using reference       = T&;
+            using const_reference = const T&;
+
+            static constexpr std::size_t tombstone_count = Layout::tombstone_count;
+
+            static void create_tombstone(storage_type& storage, std::size_t tombstone_index) noexcept
+            {
+                auto tombstone = ::new (static_cast<void*>(&storage.tombstone)) words_type;
+                std::memset(tombstone->words, 0, sizeof(tombstone->words));
+                Layout::create_tombstone(tombstone->words, tombstone_index);
+            }
+
+            template <typename... Args>
+            static void create_object(storage_type& storage, Args&&... args)
+            {
+                ::new (static_cast<void*>(&storage.object)) T(static_cast<Args&&>(args)...);
+            }
+
+            static void destroy_object(storage_type& storage) noexcept
+            {
+                storage.object.~T();
+            }
+
+            static std::size_t get_tombstone(const storage_type& storage) noexcept
+            {
+                // the object might be alive, so copy its representation
+                words_type words;
+                std::memcpy(words.words, &storage, sizeof(words.words));
+                return Layout::get_tombstone(words.words);
+            }
+
+            static reference get_object(storage_type& storage) noexcept
+            {
+                return storage.object;
+            }
+            static const_reference get_object(const storage_type& storage) noexcept
+            {
+                return storage.object;
+            }
+        };
+
+        constexpr std::size_t max_word_tombstone_count
+            = clamp_tombstone_count(std::numeric_limits<std::uintptr_t>::max());
+
+        // a pointer at word 0 whose alignment bits are set
+        template <std::size_t Alignment>
+        struct misaligned_pointer_layout
+        {
+            static constexpr std::size_t tombstone_count = Alignment - 1u;
+
+            static void create_tombstone(std::uintptr_t* words, std::size_t index) noexcept
+            {
+                words[0] = std::uintptr_t(index + 1u);
+            }
+
+            static std::size_t get_tombstone(const std::uintptr_t* words) noexcept
+            {
+                // valid pointer: 0, subtract one overflows and we have an invalid index
+                return std::size_t(words[0] % Alignment) - 1u;
+            }
+        };
+
+        // begin, end and capacity pointer with begin <= end,
+        // so a non-null begin and a null end is invalid
+        struct vector_layout
+        {
+            static constexpr std::size_t tombstone_count = max_word_tombstone_count;
+
+            static void create_tombstone(std::uintptr_t* words, std::size_t index) noexcept
+            {
+                words[0] = std::uintptr_t(index) + 1u;
+            }
+
+            static std::size_t get_tombstone(const std::uintptr_t* words) noexcept
+            {
+                if (words[1] != 0u)
+                    return std::size_t(-1);
+                return to_tombstone_index(words[0] - 1u, tombstone_count);
+            }
+        };
+
+        // a null pointer at word Pointer with the index stored at word Index
+        // Offset is added to the index, so a null pointer with a zero index can be valid
+        template <std::size_t Pointer, std::size_t Index, std::size_t Offset>
+        struct null_pointer_layout
+        {
+            static constexpr std::size_t tombstone_count = max_word_tombstone_count;
+
+            static void create_tombstone(std::uintptr_t* words, std::size_t index) noexcept
+            {
+                words[Index] = std::uintptr_t(index) + Offset;
+            }
+
+            static std::size_t get_tombstone(const std::uintptr_t* words) noexcept
+            {
+                if (words[Pointer] != 0u)
+                    return std::size_t(-1);
+                return to_tombstone_index(words[Index] - Offset, tombstone_count);
+            }
+        };
+
+#    if defined(__GLIBCXX__)
+#        if _GLIBCXX_USE_CXX11_ABI
+        // {pointer, size, {local buffer, capacity}}, pointer is never null
+        using string_layout = null_pointer_layout<0, 1, 0>;
+#            define FOONATHAN_TINY_DETAIL_STD_STRING_WORDS 4
+#        endif
+#    elif defined(_LIBCPP_VERSION) && !defined(_LIBCPP_ABI_ALTERNATE_STRING_LAYOUT)               \
+        && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        // long: {capacity with lowest bit set, size, pointer}, short: {size << 1, buffer}
+        // a long string with a null pointer is invalid
+        struct string_layout
+        {
+            static constexpr std::size_t tombstone_count = max_word_tombstone_count;
+
+            static void create_tombstone(std::uintptr_t* words, std::size_t index) noexcept
+            {
+                words[0] = 1u;
+                words[1] = std::uintptr_t(index);
+            }
+
+            static std::size_t get_tombstone(const std::uintptr_t* words) noexcept
+            {
+                if ((words[0] & 1u) == 0u || words[2] != 0u)
+                    return std::size_t(-1);
+                return to_tombstone_index(words[1], tombstone_count);
+            }
+        };
+#        define FOONATHAN_TINY_DETAIL_STD_STRING_WORDS 3
+#    endif
+
+#    if __cplusplus >= 201703L
+        // {pointer, size} resp. {size, pointer}, a null pointer with non-zero size is invalid
+#        if defined(__GLIBCXX__)
+        using string_view_layout = null_pointer_layout<1, 0, 1>;
+#        else
+        using string_view_layout = null_pointer_layout<0, 1, 1>;
+#        endif
+#    endif
+    } // namespace tombstone_detail
+
+    /// Specialization of the tombstone traits for [std::unique_ptr]() with the default deleter.
+    /// It will use the invalid alignments of the pointer.
+    /// \notes This header is opt-in and only available if `FOONATHAN_TINY_STD_TOMBSTONES` is
+    /// non-zero. The layout assumptions are checked with `static_assert()`.
+    template <typename T>
+    struct tombstone_traits<std::unique_ptr<T>>
+    : tombstone_detail::tombstone_traits_words<std::unique_ptr<T>,
+                                               tombstone_detail::misaligned_pointer_layout<
+                                                   alignof(T)>>
+    {
+        static_assert(sizeof(std::unique_ptr<T>) == sizeof(T*),
+                      "unexpected layout of std::unique_ptr");
+    };
+
+    /// Specialization of the tombstone traits for [std::vector]() with the default allocator.
+    /// It will use the invalid state where the begin pointer is after the end pointer.
+    /// \notes This header is opt-in and only available if `FOONATHAN_TINY_STD_TOMBSTONES` is
+    /// non-zero. The layout assumptions are checked with `static_assert()`.
+    template <typename T>
+    struct tombstone_traits<std::vector<T>,
+                            typename std::enable_if<!std::is_same<T, bool>::value>::type>
+    : tombstone_detail::tombstone_traits_words<std::vector<T>, tombstone_detail::vector_layout>
+    {
+        static_assert(sizeof(std::vector<T>) == 3 * sizeof(T*), "unexpected layout of std::vector");
+    };
+
+#    ifdef FOONATHAN_TINY_DETAIL_STD_STRING_WORDS
+    /// Specialization of the tombstone traits for [std::string]().
+    /// It will use a heap allocated state with a null pointer.
+    /// \notes This header is opt-in and only available if `FOONATHAN_TINY_STD_TOMBSTONES` is
+    /// non-zero. The layout assumptions are checked with `static_assert()`.
+    /// It is not available for the old copy-on-write string of libstdc++
+    /// and the alternate string layout of libc++.
+    template <>
+    struct tombstone_traits<std::string>
+    : tombstone_detail::tombstone_traits_words<std::string, tombstone_detail::string_layout>
+    {
+        static_assert(sizeof(std::string)
+                          == FOONATHAN_TINY_DETAIL_STD_STRING_WORDS * sizeof(std::uintptr_t),
+                      "unexpected layout of std::string");
+    };
+#        undef FOONATHAN_TINY_DETAIL_STD_STRING_WORDS
+#    endif
+
+#    if __cplusplus >= 201703L
+    /// Specialization of the tombstone traits for [std::string_view]().
+    /// It will use a null pointer with a non-zero size.
+    /// \notes This header is opt-in and only available if `FOONATHAN_TINY_STD_TOMBSTONES` is
+    /// non-zero. The layout assumptions are checked with `static_assert()`.
+    template <>
+    struct tombstone_traits<std::string_view>
+    : tombstone_detail::tombstone_traits_words<std::string_view,
+                                               tombstone_detail::string_view_layout>
+    {
+        static_assert(sizeof(std::string_view) == 2 * sizeof(std::uintptr_t),
+                      "unexpected layout of std::string_view");
+    };
+#    endif
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_STD_TOMBSTONES
+
+#endif // FOONATHAN_TINY_TOMBSTONE_STD_HPP_INCLUDED
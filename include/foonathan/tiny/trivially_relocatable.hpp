@@ -0,0 +1,28 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#ifndef FOONATHAN_TINY_TRIVIALLY_RELOCATABLE_HPP_INCLUDED
+#define FOONATHAN_TINY_TRIVIALLY_RELOCATABLE_HPP_INCLUDED
+
+#include <type_traits>
+
+namespace foonathan
+{
+namespace tiny
+{
+    /// Whether or not a type is trivially relocatable.
+    ///
+    /// A type is trivially relocatable if moving an object to a new location and destroying the
+    /// old one is equivalent to copying the bytes with `std::memcpy()` and not calling the
+    /// destructor. A container can then grow its buffer without calling any constructors.
+    ///
+    /// The default implementation is `std::is_trivially_copyable<T>`,
+    /// specialize it for own types that are trivially relocatable but not trivially copyable.
+    template <typename T, typename = void>
+    struct is_trivially_relocatable : std::is_trivially_copyable<T>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+#endif // FOONATHAN_TINY_TRIVIALLY_RELOCATABLE_HPP_INCLUDED
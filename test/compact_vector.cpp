@@ -0,0 +1,143 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/compact_vector.hpp>
+
+#include <catch.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+template <typename T>
+void verify(const compact_vector<T>& vec, const std::vector<T>& reference)
+{
+    REQUIRE(vec.size() == reference.size());
+    REQUIRE(vec.empty() == reference.empty());
+    REQUIRE(vec.capacity() >= vec.size());
+    REQUIRE(std::vector<T>(vec.begin(), vec.end()) == reference);
+}
+} // namespace
+
+TEST_CASE("compact_vector")
+{
+    REQUIRE(sizeof(compact_vector<std::uint32_t>) == 2 * sizeof(void*));
+    REQUIRE(sizeof(compact_vector<std::string>) == 2 * sizeof(void*));
+    REQUIRE(compact_vector<std::uint32_t>::inline_capacity()
+            == (2 * sizeof(void*) - 4u) / sizeof(std::uint32_t));
+    REQUIRE(compact_vector<std::string>::inline_capacity() == 0u);
+    REQUIRE(is_trivially_relocatable<compact_vector<std::uint32_t>>::value);
+
+    SECTION("trivial")
+    {
+        compact_vector<std::uint32_t> vec;
+        verify(vec, {});
+        REQUIRE(!vec.is_heap());
+        REQUIRE(vec.capacity() == vec.inline_capacity());
+
+        std::vector<std::uint32_t> reference;
+        for (auto i = 0u; i != vec.inline_capacity(); ++i)
+        {
+            vec.push_back(i);
+            reference.push_back(i);
+        }
+        REQUIRE(!vec.is_heap());
+        verify(vec, reference);
+
+        for (auto i = 0u; i != 100u; ++i)
+        {
+            vec.push_back(i * i);
+            reference.push_back(i * i);
+            verify(vec, reference);
+        }
+        REQUIRE(vec.is_heap());
+        REQUIRE(vec.capacity() == 128u);
+
+        // the argument refers to an element that is relocated when growing
+        vec.resize(128u);
+        reference.resize(128u);
+        vec.push_back(vec[5]);
+        reference.push_back(reference[5]);
+        verify(vec, reference);
+
+        vec.pop_back();
+        reference.pop_back();
+        REQUIRE(vec.back() == reference.back());
+        REQUIRE(vec.front() == 0u);
+        verify(vec, reference);
+
+        vec.resize(10u);
+        reference.resize(10u);
+        verify(vec, reference);
+
+        vec.clear();
+        REQUIRE(vec.is_heap());
+        verify(vec, {});
+
+        vec.reserve(1000u);
+        REQUIRE(vec.capacity() == 1024u);
+    }
+    SECTION("non-trivial")
+    {
+        compact_vector<std::string> vec;
+        REQUIRE(vec.capacity() == 0u);
+
+        std::vector<std::string> reference;
+        for (auto i = 0; i != 50; ++i)
+        {
+            auto str = std::string(std::size_t(i), 'a') + std::to_string(i);
+            vec.push_back(str);
+            reference.push_back(str);
+        }
+        verify(vec, reference);
+
+        vec.emplace_back(vec.front());
+        reference.emplace_back(reference.front());
+        verify(vec, reference);
+
+        vec.reserve(200u);
+        verify(vec, reference);
+        REQUIRE(vec.capacity() == 256u);
+    }
+    SECTION("copy and move")
+    {
+        compact_vector<std::uint32_t> small;
+        small.push_back(1u);
+        small.push_back(2u);
+
+        compact_vector<std::uint32_t> big;
+        for (auto i = 0u; i != 20u; ++i)
+            big.push_back(i);
+        std::vector<std::uint32_t> big_reference(big.begin(), big.end());
+
+        auto small_copy = small;
+        verify(small_copy, {1u, 2u});
+        auto big_copy = big;
+        verify(big_copy, big_reference);
+
+        auto small_move = std::move(small_copy);
+        verify(small_move, {1u, 2u});
+        verify(small_copy, {});
+        auto big_move = std::move(big_copy);
+        verify(big_move, big_reference);
+        verify(big_copy, {});
+        REQUIRE(!big_copy.is_heap());
+
+        small_move = std::move(big_move);
+        verify(small_move, big_reference);
+        big_move = small;
+        verify(big_move, {1u, 2u});
+
+        compact_vector<std::string> strings;
+        strings.push_back("hello");
+        strings.push_back("world");
+        auto strings_copy = strings;
+        strings           = std::move(strings_copy);
+        verify(strings, {"hello", "world"});
+    }
+}
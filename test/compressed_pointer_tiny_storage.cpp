@@ -0,0 +1,103 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/compressed_pointer_tiny_storage.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+struct test_arena
+{
+    static std::uint64_t* base() noexcept
+    {
+        static std::uint64_t memory[64];
+        return memory;
+    }
+};
+} // namespace
+
+TEST_CASE("compressed_pointer_tiny_storage")
+{
+    auto arena = test_arena::base();
+
+    SECTION("no tiny types")
+    {
+        using storage = compressed_pointer_tiny_storage<std::uint64_t, test_arena>;
+        REQUIRE(sizeof(storage) == 4u);
+        REQUIRE(storage::max_arena_size() == ((std::uint64_t(1) << 32) - 1u) * 8u);
+
+        storage s;
+        REQUIRE((s.pointer() == nullptr));
+
+        s.pointer() = arena;
+        REQUIRE((s.pointer() == arena));
+
+        s.pointer() = arena + 63;
+        REQUIRE((s.pointer() == arena + 63));
+
+        s.pointer() = nullptr;
+        REQUIRE((s.pointer() == nullptr));
+
+        storage other(arena + 5);
+        REQUIRE((other.pointer() == arena + 5));
+        REQUIRE(is_trivially_relocatable<storage>::value);
+    }
+    SECTION("tiny types")
+    {
+        using storage = compressed_pointer_tiny_storage<std::uint64_t, test_arena,
+                                                        tiny_unsigned<3>, tiny_bool>;
+        REQUIRE(sizeof(storage) == 4u);
+        REQUIRE(storage::max_arena_size() == ((std::uint64_t(1) << 28) - 1u) * 8u);
+
+        storage s(arena + 2, 5u, true);
+        REQUIRE((s.pointer() == arena + 2));
+        REQUIRE(s.at<0>() == 5u);
+        REQUIRE(s.at<1>());
+
+        s.pointer() += 3;
+        REQUIRE((s.pointer() == arena + 5));
+        REQUIRE(s.at<0>() == 5u);
+        REQUIRE(s.at<1>());
+
+        auto ptr = s.pointer()++;
+        REQUIRE(ptr == arena + 5);
+        REQUIRE((s.pointer() == arena + 6));
+
+        --s.pointer();
+        REQUIRE((s.pointer() == arena + 5));
+
+        s.at<0>() = 2u;
+        s.at<1>() = false;
+        REQUIRE((s.pointer() == arena + 5));
+
+        s.pointer() = nullptr;
+        REQUIRE((s.pointer() == nullptr));
+        REQUIRE(s.at<0>() == 2u);
+        REQUIRE(!s.at<1>());
+
+        const auto& cs = s;
+        REQUIRE((cs.pointer() == nullptr));
+        REQUIRE(cs.at<0>() == 2u);
+    }
+    SECTION("custom alignment")
+    {
+        using storage = compressed_pointer_tiny_storage<aligned_obj<std::uint32_t, 16>,
+                                                        test_arena, tiny_unsigned<4>>;
+        REQUIRE(storage::max_arena_size() == ((std::uint64_t(1) << 28) - 1u) * 16u);
+
+        auto ptr = reinterpret_cast<std::uint32_t*>(arena + 4);
+        storage s(ptr, 9u);
+        REQUIRE((s.pointer() == ptr));
+        REQUIRE(s.tiny() == 9u);
+
+        const auto& cs = s;
+        REQUIRE((cs.pointer() == ptr));
+    }
+}
@@ -0,0 +1,37 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/detail/bit_count.hpp>
+
+#include <catch.hpp>
+
+using namespace foonathan::tiny::detail;
+
+TEST_CASE("detail::popcount")
+{
+    REQUIRE(popcount(0u) == 0u);
+    REQUIRE(popcount(1u) == 1u);
+    REQUIRE(popcount(0xFFu) == 8u);
+    REQUIRE(popcount(0x8000000000000001u) == 2u);
+    REQUIRE(popcount(0xFFFFFFFFFFFFFFFFu) == 64u);
+    REQUIRE(popcount(0x5555555555555555u) == 32u);
+}
+
+TEST_CASE("detail::count_trailing_zeros")
+{
+    REQUIRE(count_trailing_zeros(1u) == 0u);
+    REQUIRE(count_trailing_zeros(2u) == 1u);
+    REQUIRE(count_trailing_zeros(0xF0u) == 4u);
+    REQUIRE(count_trailing_zeros(0x8000000000000000u) == 63u);
+    REQUIRE(count_trailing_zeros(0xFFFFFFFFFFFFFFFFu) == 0u);
+}
+
+TEST_CASE("detail::count_leading_zeros")
+{
+    REQUIRE(count_leading_zeros(1u) == 63u);
+    REQUIRE(count_leading_zeros(2u) == 62u);
+    REQUIRE(count_leading_zeros(0xF0u) == 56u);
+    REQUIRE(count_leading_zeros(0x8000000000000000u) == 0u);
+    REQUIRE(count_leading_zeros(0x00000001FFFFFFFFu) == 31u);
+}
@@ -0,0 +1,189 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/dna_sequence.hpp>
+
+#include <catch.hpp>
+
+#include <cstring>
+#include <string>
+
+#include <foonathan/tiny/tiny_enum.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+std::string to_string(const dna_sequence& seq)
+{
+    std::string result(seq.size(), '\0');
+    if (!seq.empty())
+        seq.to_ascii(&result[0]);
+    return result;
+}
+
+dna_sequence from_string(const std::string& str)
+{
+    return dna_sequence(str.data(), str.size());
+}
+
+std::string reference_reverse_complement(const std::string& str)
+{
+    std::string result;
+    for (auto iter = str.rbegin(); iter != str.rend(); ++iter)
+        switch (*iter)
+        {
+        case 'A':
+            result += 'T';
+            break;
+        case 'C':
+            result += 'G';
+            break;
+        case 'G':
+            result += 'C';
+            break;
+        case 'T':
+            result += 'A';
+            break;
+        }
+    return result;
+}
+
+// deterministic pseudo random sequence
+std::string make_sequence(std::size_t size, std::size_t seed)
+{
+    std::string result;
+    for (auto i = std::size_t(0); i != size; ++i)
+    {
+        seed = seed * 6364136223846793005u + 1442695040888963407u;
+        result += "ACGT"[(seed >> 33) & 3u];
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("dna_sequence")
+{
+    SECTION("nucleotide")
+    {
+        REQUIRE(tiny_enum<nucleotide>::bit_size() == 2u);
+        REQUIRE(complement(nucleotide::A) == nucleotide::T);
+        REQUIRE(complement(nucleotide::T) == nucleotide::A);
+        REQUIRE(complement(nucleotide::C) == nucleotide::G);
+        REQUIRE(complement(nucleotide::G) == nucleotide::C);
+    }
+    SECTION("basic")
+    {
+        dna_sequence seq;
+        REQUIRE(seq.empty());
+        REQUIRE(seq.size() == 0u);
+
+        // 32 nucleotides per word
+        seq.reserve(100u);
+        REQUIRE(seq.capacity() >= 128u);
+
+        seq.push_back(nucleotide::G);
+        seq.push_back(nucleotide::A);
+        seq.push_back(nucleotide::T);
+        REQUIRE(seq.size() == 3u);
+        REQUIRE(seq[0] == nucleotide::G);
+        REQUIRE(seq[1] == nucleotide::A);
+        REQUIRE(seq[2] == nucleotide::T);
+        REQUIRE(to_string(seq) == "GAT");
+
+        seq.set(1, nucleotide::C);
+        REQUIRE(to_string(seq) == "GCT");
+
+        seq.clear();
+        REQUIRE(seq.empty());
+        REQUIRE(seq == dna_sequence());
+
+        for (auto i = 0u; i != 70u; ++i)
+            seq.push_back(nucleotide(i % 4u));
+        REQUIRE(seq.size() == 70u);
+        for (auto i = 0u; i != 70u; ++i)
+            REQUIRE(seq[i] == nucleotide(i % 4u));
+        REQUIRE(seq == from_string(to_string(seq)));
+    }
+    SECTION("ascii")
+    {
+        for (auto size : {0u, 1u, 7u, 8u, 31u, 32u, 33u, 64u, 65u, 100u})
+        {
+            auto str = make_sequence(size, size);
+            auto seq = from_string(str);
+            REQUIRE(seq.size() == size);
+            REQUIRE(to_string(seq) == str);
+            for (auto i = 0u; i != size; ++i)
+                REQUIRE("ACTG"[std::size_t(seq[i])] == str[i]);
+        }
+
+        // longer than any fixed capacity would reasonably be
+        auto long_str = make_sequence(1000000u, 3u);
+        auto long_seq = from_string(long_str);
+        REQUIRE(long_seq.size() == long_str.size());
+        REQUIRE(to_string(long_seq) == long_str);
+
+        auto lower = from_string("acgtACGTacgtacgtacgtacgtacgtacgtacgt");
+        REQUIRE(to_string(lower) == "ACGTACGTACGTACGTACGTACGTACGTACGTACGT");
+    }
+    SECTION("reverse_complement")
+    {
+        REQUIRE(to_string(from_string("ACCGT").reverse_complement()) == "ACGGT");
+        REQUIRE(dna_sequence().reverse_complement().empty());
+
+        for (auto size : {1u, 5u, 31u, 32u, 33u, 63u, 64u, 65u, 100u, 128u})
+        {
+            auto str = make_sequence(size, 2u * size);
+            auto seq = from_string(str);
+            auto rc  = seq.reverse_complement();
+            REQUIRE(to_string(rc) == reference_reverse_complement(str));
+            REQUIRE(rc.reverse_complement() == seq);
+        }
+    }
+    SECTION("kmer")
+    {
+        auto str = make_sequence(100, 42u);
+        auto seq = from_string(str);
+
+        for (auto k : {1u, 5u, 31u, 32u})
+        {
+            auto count = std::size_t(0);
+            seq.for_each_kmer(k, [&](std::size_t pos, std::uint64_t kmer) {
+                REQUIRE(pos == count);
+                for (auto i = 0u; i != k; ++i)
+                {
+                    auto base = nucleotide((kmer >> (2u * i)) & 3u);
+                    REQUIRE("ACTG"[std::size_t(base)] == str[pos + i]);
+                }
+                REQUIRE(kmer == seq.kmer(pos, k));
+                ++count;
+            });
+            REQUIRE(count == 100u - k + 1u);
+        }
+
+        auto small = from_string("GATTACA");
+        REQUIRE(small.kmer(0, 2) == (std::uint64_t(nucleotide::G)
+                                     | std::uint64_t(nucleotide::A) << 2));
+        auto none = 0;
+        small.for_each_kmer(8, [&](std::size_t, std::uint64_t) { ++none; });
+        REQUIRE(none == 0);
+    }
+    SECTION("hamming_distance")
+    {
+        REQUIRE(hamming_distance(dna_sequence(), dna_sequence()) == 0u);
+        REQUIRE(hamming_distance(from_string("ACGT"), from_string("ACGT")) == 0u);
+        REQUIRE(hamming_distance(from_string("ACGT"), from_string("TGCA")) == 4u);
+        REQUIRE(hamming_distance(from_string("AAAA"), from_string("ACAT")) == 2u);
+
+        auto str = make_sequence(100, 7u);
+        auto seq = from_string(str);
+        auto other_str = str;
+        for (auto i : {0u, 31u, 32u, 50u, 99u})
+            other_str[i] = other_str[i] == 'A' ? 'G' : 'A';
+        auto other = from_string(other_str);
+        REQUIRE(hamming_distance(seq, other) == 5u);
+        REQUIRE(hamming_distance(other, seq) == 5u);
+        REQUIRE(seq != other);
+    }
+}
@@ -0,0 +1,75 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/frequency_sketch.hpp>
+
+#include <catch.hpp>
+
+#include <memory>
+
+using namespace foonathan::tiny;
+
+TEST_CASE("frequency_sketch")
+{
+    SECTION("basic")
+    {
+        frequency_sketch<64> sketch;
+        REQUIRE(sketch.sample_size() == 640u);
+        REQUIRE(sketch.estimate(42u) == 0u);
+
+        for (auto i = 1u; i <= 15u; ++i)
+        {
+            sketch.increment(42u);
+            REQUIRE(sketch.estimate(42u) == i);
+        }
+        REQUIRE(sketch.additions() == 15u);
+
+        // saturated
+        sketch.increment(42u);
+        REQUIRE(sketch.estimate(42u) == 15u);
+        REQUIRE(sketch.additions() == 15u);
+
+        sketch.reset();
+        REQUIRE(sketch.estimate(42u) == 7u);
+
+        sketch.clear();
+        REQUIRE(sketch.estimate(42u) == 0u);
+        REQUIRE(sketch.additions() == 0u);
+    }
+    SECTION("never underestimates")
+    {
+        // 64 KiB, so allocate it on the heap
+        std::unique_ptr<frequency_sketch<8192>> sketch(new frequency_sketch<8192>);
+
+        for (auto key = 0u; key != 1000u; ++key)
+            for (auto i = 0u; i != key % 16u; ++i)
+                sketch->increment(key);
+
+        auto exact = 0u;
+        for (auto key = 0u; key != 1000u; ++key)
+        {
+            auto estimate = sketch->estimate(key);
+            REQUIRE(estimate >= key % 16u);
+            if (estimate == key % 16u)
+                ++exact;
+        }
+        REQUIRE(exact > 900u);
+    }
+    SECTION("aging")
+    {
+        frequency_sketch<16> sketch;
+        for (auto i = 0u; i != 8u; ++i)
+            sketch.increment(1u);
+        REQUIRE(sketch.estimate(1u) == 8u);
+
+        // the 160th increment halves everything
+        for (auto i = 8u; i != 159u; ++i)
+            sketch.increment(1000u + i);
+        REQUIRE(sketch.estimate(1u) >= 8u);
+        sketch.increment(1000u);
+        REQUIRE(sketch.estimate(1u) >= 4u);
+        REQUIRE(sketch.estimate(1u) < 8u);
+        REQUIRE(sketch.additions() < 80u);
+    }
+}
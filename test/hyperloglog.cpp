@@ -0,0 +1,79 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/hyperloglog.hpp>
+
+#include <catch.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+template <std::size_t Precision>
+void add_range(hyperloglog<Precision>& hll, std::size_t begin, std::size_t end)
+{
+    for (auto i = begin; i != end; ++i)
+        hll.add(i);
+}
+
+void require_close(double estimate, double expected, double error)
+{
+    REQUIRE(estimate > expected * (1. - error));
+    REQUIRE(estimate < expected * (1. + error));
+}
+} // namespace
+
+TEST_CASE("hyperloglog")
+{
+    SECTION("basic")
+    {
+        REQUIRE(sizeof(hyperloglog<4>) == 12u);
+        REQUIRE(sizeof(hyperloglog<10>) == 768u);
+
+        hyperloglog<10> hll;
+        REQUIRE(hll.size() == 1024u);
+        REQUIRE(hll.estimate() == 0.);
+
+        for (auto i = 0; i != 1000; ++i)
+            hll.add(42u);
+        require_close(hll.estimate(), 1., 0.01);
+
+        add_range(hll, 0u, 100u);
+        require_close(hll.estimate(), 100., 0.05);
+
+        for (auto i = 0u; i != hll.size(); ++i)
+            REQUIRE(hll[i] <= 64u - 10u + 1u);
+
+        hll.clear();
+        REQUIRE(hll.estimate() == 0.);
+    }
+    SECTION("big")
+    {
+        hyperloglog<12> hll;
+        add_range(hll, 0u, 100000u);
+        require_close(hll.estimate(), 100000., 0.05);
+
+        // adding them again doesn't change anything
+        add_range(hll, 0u, 100000u);
+        require_close(hll.estimate(), 100000., 0.05);
+    }
+    SECTION("merge")
+    {
+        hyperloglog<8> a;
+        add_range(a, 0u, 5000u);
+        hyperloglog<8> b;
+        add_range(b, 2500u, 7500u);
+
+        hyperloglog<8> merged = a;
+        merged.merge(b);
+        for (auto i = 0u; i != merged.size(); ++i)
+            REQUIRE(merged[i] == (a[i] < b[i] ? b[i] : a[i]));
+        require_close(merged.estimate(), 7500., 0.15);
+
+        hyperloglog<8> expected;
+        add_range(expected, 0u, 7500u);
+        for (auto i = 0u; i != merged.size(); ++i)
+            REQUIRE(merged[i] == expected[i]);
+    }
+}
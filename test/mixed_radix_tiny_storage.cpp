@@ -0,0 +1,167 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/mixed_radix_tiny_storage.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/tiny/optional_impl.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_enum.hpp>
+#include <foonathan/tiny/tiny_flag_set.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_optional.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+enum class status
+{
+    idle,
+    running,
+    blocked,
+    done,
+    failed,
+
+    _unsigned_count,
+};
+
+enum class mixed_flags
+{
+    a,
+    b,
+    c,
+
+    flag_count_,
+};
+} // namespace
+
+TEST_CASE("mixed_radix_tiny_storage")
+{
+    SECTION("basic")
+    {
+        using digit   = tiny_int_range<0, 4>;
+        using storage = mixed_radix_tiny_storage<digit, digit, digit, digit, digit>;
+        REQUIRE(total_bit_size<digit, digit, digit, digit, digit>() == 15u);
+        REQUIRE(mixed_radix_bit_size<digit, digit, digit, digit, digit>() == 12u);
+        REQUIRE(sizeof(storage) == 2u);
+
+        storage     s;
+        const auto& cs = s;
+        REQUIRE(s.at<0>() == 0);
+        REQUIRE(s.at<1>() == 0);
+        REQUIRE(s.at<2>() == 0);
+        REQUIRE(s.at<3>() == 0);
+        REQUIRE(s.at<4>() == 0);
+
+        s.at<0>() = 4;
+        s.at<2>() = 3;
+        s.at<4>() = 4;
+        REQUIRE(s.at<0>() == 4);
+        REQUIRE(s.at<1>() == 0);
+        REQUIRE(s.at<2>() == 3);
+        REQUIRE(s.at<3>() == 0);
+        REQUIRE(s.at<4>() == 4);
+        REQUIRE(cs.at<0>() == 4);
+        REQUIRE(cs.at<2>() == 3);
+        REQUIRE(cs.at<4>() == 4);
+
+        s.at<2>() = 1;
+        s.at<1>() = 2;
+        REQUIRE(s.at<0>() == 4);
+        REQUIRE(s.at<1>() == 2);
+        REQUIRE(s.at<2>() == 1);
+        REQUIRE(s.at<3>() == 0);
+        REQUIRE(s.at<4>() == 4);
+
+        s = storage(1, 2, 3, 4, 0);
+        REQUIRE(s.at<0>() == 1);
+        REQUIRE(s.at<1>() == 2);
+        REQUIRE(s.at<2>() == 3);
+        REQUIRE(s.at<3>() == 4);
+        REQUIRE(s.at<4>() == 0);
+    }
+    SECTION("all combinations")
+    {
+        using storage = mixed_radix_tiny_storage<tiny_int_range<0, 2>, tiny_int_range<-2, 2>,
+                                                 tiny_int_range<0, 6>>;
+        REQUIRE(mixed_radix_bit_size<tiny_int_range<0, 2>, tiny_int_range<-2, 2>,
+                                     tiny_int_range<0, 6>>()
+                == 7u);
+        REQUIRE(sizeof(storage) == 1u);
+
+        storage s;
+        for (auto a = 0; a <= 2; ++a)
+            for (auto b = -2; b <= 2; ++b)
+                for (auto c = 0; c <= 6; ++c)
+                {
+                    s = storage(a, b, c);
+                    REQUIRE(s.at<0>() == a);
+                    REQUIRE(s.at<1>() == b);
+                    REQUIRE(s.at<2>() == c);
+                }
+    }
+    SECTION("mixed tiny types")
+    {
+        using storage = mixed_radix_tiny_storage<tiny_enum<status>, tiny_bool, tiny_int<3>,
+                                                 tiny_flag_set<mixed_flags>,
+                                                 tiny_optional<tiny_int_range<0, 2>>>;
+        // 5 * 2 * 8 * 8 * 4 = 2560
+        REQUIRE(sizeof(storage) == 2u);
+
+        storage s;
+        REQUIRE(s.at<0>() == status::idle);
+        REQUIRE(s.at<1>() == false);
+        REQUIRE(s.at<2>() == 0);
+        REQUIRE(s.at<3>().none());
+        REQUIRE(!s.at<4>().has_value());
+
+        s.at<0>() = status::failed;
+        s.at<1>() = true;
+        s.at<2>() = -3;
+        s.at<3>() = flags(mixed_flags::a, mixed_flags::c);
+        s.at<4>() = 2;
+        REQUIRE(s.at<0>() == status::failed);
+        REQUIRE(s.at<1>() == true);
+        REQUIRE(s.at<2>() == -3);
+        REQUIRE(s.at<3>() == flags(mixed_flags::a, mixed_flags::c));
+        REQUIRE(s.at<4>().has_value());
+        REQUIRE(s.at<4>() == 2);
+
+        s.at<3>()[mixed_flags::b] = true;
+        s.at<3>().reset(mixed_flags::a);
+        REQUIRE(s.at<3>() == flags(mixed_flags::b, mixed_flags::c));
+        s.at<3>().set_all();
+        REQUIRE(s.at<3>().all());
+
+        s.at<2>() = 3;
+        s.at<4>().reset();
+        REQUIRE(s.at<0>() == status::failed);
+        REQUIRE(s.at<1>() == true);
+        REQUIRE(s.at<2>() == 3);
+        REQUIRE(s.at<3>().all());
+        REQUIRE(!s.at<4>().has_value());
+    }
+    SECTION("spare bits")
+    {
+        using storage = mixed_radix_tiny_storage<tiny_int_range<0, 4>, tiny_int_range<0, 4>,
+                                                 tiny_int_range<0, 4>, tiny_int_range<0, 4>,
+                                                 tiny_int_range<0, 4>>;
+
+        storage s(4, 4, 4, 4, 4);
+        REQUIRE(s.spare_bits().size() == 4u);
+        REQUIRE(s.spare_bits().extract() == 0u);
+
+        s.spare_bits().put(0xF);
+        REQUIRE(s.spare_bits().extract() == 0xF);
+        REQUIRE(s.at<0>() == 4);
+        REQUIRE(s.at<4>() == 4);
+
+        // the spare bits make tombstones
+        using traits = tombstone_traits<storage>;
+        REQUIRE(std::size_t(traits::tombstone_count) == 15u);
+        REQUIRE(sizeof(optional_impl<storage>) == sizeof(storage));
+    }
+}
@@ -0,0 +1,161 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/optional_array.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <foonathan/tiny/tiny_int.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+template <typename T, std::size_t Size>
+std::vector<std::size_t> present_indices(const optional_array<T, Size>& array)
+{
+    std::vector<std::size_t> result;
+    array.for_each_present(
+        [&](std::size_t index, typename tombstone_traits<T>::const_reference value) {
+            REQUIRE(array.has_value(index));
+            REQUIRE(array.value(index) == value);
+            result.push_back(index);
+        });
+    return result;
+}
+
+template <typename T, std::size_t Size, typename Make>
+void verify_optional_array(bool is_compressed, Make make)
+{
+    using array_t = optional_array<T, Size>;
+    REQUIRE(array_t::is_compressed::value == is_compressed);
+    REQUIRE(array_t::size() == Size);
+
+    array_t array;
+    REQUIRE(array.count_present() == 0u);
+    REQUIRE(present_indices(array).empty());
+    for (auto i = 0u; i != Size; ++i)
+        REQUIRE(!array.has_value(i));
+
+    // every third element and the last one
+    std::vector<std::size_t> expected;
+    for (auto i = 0u; i < Size; i += 3)
+        expected.push_back(i);
+    if (expected.back() != Size - 1u)
+        expected.push_back(Size - 1u);
+
+    for (auto i : expected)
+        array.create_value(i, make(i));
+    REQUIRE(array.count_present() == expected.size());
+    REQUIRE(present_indices(array) == expected);
+    for (auto i = 0u; i != Size; ++i)
+    {
+        auto present = std::find(expected.begin(), expected.end(), i) != expected.end();
+        REQUIRE(array.has_value(i) == present);
+        if (present)
+            REQUIRE(array.value(i) == make(i));
+    }
+
+    // remove the first one
+    array.destroy_value(0u);
+    REQUIRE(array.count_present() == expected.size() - 1u);
+    expected.erase(expected.begin());
+    REQUIRE(present_indices(array) == expected);
+
+    // compact
+    REQUIRE(array.compact() == expected.size());
+    REQUIRE(array.count_present() == expected.size());
+    for (auto i = 0u; i != Size; ++i)
+    {
+        REQUIRE(array.has_value(i) == (i < expected.size()));
+        if (i < expected.size())
+            REQUIRE(array.value(i) == make(expected[i]));
+    }
+
+    // compacting twice does nothing
+    REQUIRE(array.compact() == expected.size());
+    REQUIRE(array.count_present() == expected.size());
+
+    // fill everything
+    for (auto i = expected.size(); i != Size; ++i)
+        array.create_value(i, make(i));
+    REQUIRE(array.count_present() == Size);
+    REQUIRE(array.compact() == Size);
+}
+
+bool make_bool(std::size_t i)
+{
+    return i % 2 == 0;
+}
+
+int  ints[256];
+int* make_ptr(std::size_t i)
+{
+    return &ints[i];
+}
+
+int make_int(std::size_t i)
+{
+    return static_cast<int>(i);
+}
+
+unsigned make_tiny(std::size_t i)
+{
+    return static_cast<unsigned>(i % 16);
+}
+
+std::string make_string(std::size_t i)
+{
+    return std::string(i + 1, 'a');
+}
+} // namespace
+
+TEST_CASE("optional_array")
+{
+    SECTION("bool")
+    {
+        verify_optional_array<bool, 1>(true, make_bool);
+        verify_optional_array<bool, 7>(true, make_bool);
+        verify_optional_array<bool, 64>(true, make_bool);
+        verify_optional_array<bool, 100>(true, make_bool);
+        verify_optional_array<bool, 256>(true, make_bool);
+    }
+    SECTION("pointer")
+    {
+        verify_optional_array<int*, 1>(true, make_ptr);
+        verify_optional_array<int*, 65>(true, make_ptr);
+        verify_optional_array<int*, 100>(true, make_ptr);
+        verify_optional_array<int*, 256>(true, make_ptr);
+    }
+    SECTION("tiny type")
+    {
+        verify_optional_array<tiny_unsigned<4>, 3>(true, make_tiny);
+        verify_optional_array<tiny_unsigned<4>, 130>(true, make_tiny);
+    }
+    SECTION("not compressed")
+    {
+        verify_optional_array<int, 5>(false, make_int);
+        verify_optional_array<int, 200>(false, make_int);
+        verify_optional_array<std::string, 70>(false, make_string);
+    }
+    SECTION("sparse bool")
+    {
+        optional_array<bool, 1000> array;
+        array.create_value(999u, true);
+        array.create_value(500u, false);
+        array.create_value(7u, true);
+        REQUIRE(array.count_present() == 3u);
+        REQUIRE(present_indices(array) == std::vector<std::size_t>{7u, 500u, 999u});
+
+        REQUIRE(array.compact() == 3u);
+        REQUIRE(array.value(0u) == true);
+        REQUIRE(array.value(1u) == false);
+        REQUIRE(array.value(2u) == true);
+        REQUIRE(!array.has_value(3u));
+    }
+}
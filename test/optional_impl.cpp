@@ -6,7 +6,13 @@
 
 #include <catch.hpp>
 
+#include <cmath>
+#include <limits>
+
+#include <foonathan/tiny/pointer_tiny_storage.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
 #include <foonathan/tiny/tiny_enum.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
 
 using namespace foonathan::tiny;
 
@@ -31,6 +37,40 @@ void verify_optional_impl(const T& obj, bool is_compressed)
 
     opt.destroy_value();
     REQUIRE(!opt.has_value());
+
+    // copy
+    opt.create_value(obj);
+    optional_impl<T> copy(opt);
+    REQUIRE(copy.has_value());
+    REQUIRE(copy.value() == obj);
+
+    optional_impl<T> empty;
+    optional_impl<T> empty_copy(empty);
+    REQUIRE(!empty_copy.has_value());
+
+    empty_copy = copy;
+    REQUIRE(empty_copy.has_value());
+    REQUIRE(empty_copy.value() == obj);
+
+    copy = empty;
+    REQUIRE(!copy.has_value());
+
+    // move
+    optional_impl<T> moved(std::move(empty_copy));
+    REQUIRE(moved.has_value());
+    REQUIRE(moved.value() == obj);
+
+    copy = std::move(opt);
+    REQUIRE(copy.has_value());
+    REQUIRE(copy.value() == obj);
+
+    moved = std::move(empty);
+    REQUIRE(!moved.has_value());
+
+    // moved-from values are still there
+    opt.destroy_value();
+    empty_copy.destroy_value();
+    copy.destroy_value();
 }
 
 enum class foo
@@ -40,6 +80,14 @@ enum class foo
     c,
     _unsigned_count,
 };
+
+enum class bar : std::uint16_t
+{
+    a,
+    b,
+    c,
+    _unsigned_count,
+};
 } // namespace
 
 namespace foonathan
@@ -52,6 +100,44 @@ namespace tiny
 } // namespace tiny
 } // namespace foonathan
 
+namespace
+{
+struct record
+{
+    std::uint32_t id;
+    double        value;
+
+    friend bool operator==(const record& lhs, const record& rhs)
+    {
+        return lhs.id == rhs.id && lhs.value == rhs.value;
+    }
+};
+} // namespace
+
+namespace
+{
+struct move_only
+{
+    int value;
+
+    move_only(int value) : value(value) {}
+
+    move_only(move_only&&) = default;
+    move_only& operator=(move_only&&) = default;
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct tombstone_traits<record>
+    : tombstone_traits_member<record, FOONATHAN_TINY_MEMBER(record, value)>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
 TEST_CASE("optional_impl")
 {
     SECTION("not compressed")
@@ -76,6 +162,90 @@ TEST_CASE("optional_impl")
         verify_optional_impl(foo::b, true);
         verify_optional_impl(foo::c, true);
     }
+    SECTION("compressed: enum with enum_traits")
+    {
+        REQUIRE(sizeof(optional_impl<bar>) == sizeof(bar));
+        REQUIRE(sizeof(optional_impl<optional_impl<bar>>) == sizeof(bar));
+        verify_optional_impl(bar::a, true);
+        verify_optional_impl(bar::b, true);
+        verify_optional_impl(bar::c, true);
+
+        optional_impl<optional_impl<bar>> opt;
+        REQUIRE(!opt.has_value());
+        opt.create_value();
+        REQUIRE(opt.has_value());
+        REQUIRE(!opt.value().has_value());
+        opt.value().create_value(bar::c);
+        REQUIRE(opt.value().has_value());
+        REQUIRE(opt.value().value() == bar::c);
+        opt.value().destroy_value();
+        REQUIRE(!opt.value().has_value());
+        opt.destroy_value();
+        REQUIRE(!opt.has_value());
+    }
+    SECTION("compressed: floating point")
+    {
+        REQUIRE(sizeof(optional_impl<float>) == sizeof(float));
+        REQUIRE(sizeof(optional_impl<double>) == sizeof(double));
+        verify_optional_impl(0.f, true);
+        verify_optional_impl(-1.5f, true);
+        verify_optional_impl(0., true);
+        verify_optional_impl(3.14, true);
+        verify_optional_impl(std::numeric_limits<double>::infinity(), true);
+        verify_optional_impl(-std::numeric_limits<double>::infinity(), true);
+
+        optional_impl<double> nan;
+        REQUIRE(!nan.has_value());
+        nan.create_value(std::numeric_limits<double>::quiet_NaN());
+        REQUIRE(nan.has_value());
+        REQUIRE(std::isnan(nan.value()));
+        nan.destroy_value();
+        REQUIRE(!nan.has_value());
+    }
+    SECTION("compressed: member")
+    {
+        // uses the tombstones of the double
+        REQUIRE(sizeof(optional_impl<record>) == sizeof(record));
+        REQUIRE(sizeof(optional_impl<optional_impl<record>>) == sizeof(record));
+
+        verify_optional_impl(record{0, 0.}, true);
+        verify_optional_impl(record{42, 3.14}, true);
+    }
+    SECTION("compressed: tiny storage")
+    {
+        using storage_t = pointer_tiny_storage<aligned_obj<int, 8>, tiny_bool>;
+        REQUIRE(sizeof(optional_impl<storage_t>) == sizeof(storage_t));
+        REQUIRE(sizeof(optional_impl<tiny_storage<tiny_unsigned<5>>>) == 1u);
+
+        alignas(8) int           i;
+        optional_impl<storage_t> opt;
+        REQUIRE(!opt.has_value());
+        opt.create_value(&i, true);
+        REQUIRE(opt.has_value());
+        REQUIRE(opt.value().pointer() == &i);
+        REQUIRE(opt.value().tiny() == true);
+        opt.value().tiny() = false;
+        REQUIRE(opt.has_value());
+        opt.destroy_value();
+        REQUIRE(!opt.has_value());
+    }
+    SECTION("compressed: tiny type")
+    {
+        using opt_t = optional_impl<tiny_int_range<0, 5>>;
+        REQUIRE(opt_t::is_compressed::value);
+        REQUIRE(sizeof(opt_t) == 1u);
+        REQUIRE(sizeof(optional_impl<opt_t>) == 1u);
+
+        opt_t opt;
+        REQUIRE(!opt.has_value());
+        opt.create_value(5);
+        REQUIRE(opt.has_value());
+        REQUIRE(opt.value() == 5);
+        opt.value() = 3;
+        REQUIRE(opt.value() == 3);
+        opt.destroy_value();
+        REQUIRE(!opt.has_value());
+    }
     SECTION("compressed: optional optional bool")
     {
         using opt_t = optional_impl<optional_impl<bool>>;
@@ -110,6 +280,49 @@ TEST_CASE("optional_impl")
         opt.destroy_value();
         REQUIRE(!opt.has_value());
     }
+    SECTION("copy: optional optional string")
+    {
+        using opt_t = optional_impl<optional_impl<std::string>>;
+        REQUIRE(!std::is_trivially_copyable<opt_t>::value);
+
+        opt_t opt;
+        opt.create_value();
+        opt.value().create_value("hello");
+
+        opt_t copy(opt);
+        REQUIRE(copy.has_value());
+        REQUIRE(copy.value().has_value());
+        REQUIRE(copy.value().value() == "hello");
+
+        opt_t moved(std::move(copy));
+        REQUIRE(moved.has_value());
+        REQUIRE(moved.value().has_value());
+        REQUIRE(moved.value().value() == "hello");
+
+        opt.value().destroy_value();
+        copy.value().destroy_value();
+        moved.value().destroy_value();
+    }
+    SECTION("move only")
+    {
+        using opt_t = optional_impl<move_only>;
+        static_assert(!std::is_copy_constructible<opt_t>::value, "");
+        static_assert(!std::is_copy_assignable<opt_t>::value, "");
+        static_assert(std::is_move_constructible<opt_t>::value, "");
+        static_assert(std::is_move_assignable<opt_t>::value, "");
+
+        opt_t opt;
+        opt.create_value(42);
+
+        opt_t moved(std::move(opt));
+        REQUIRE(moved.has_value());
+        REQUIRE(moved.value().value == 42);
+
+        opt.destroy_value();
+        opt = std::move(moved);
+        REQUIRE(opt.has_value());
+        REQUIRE(opt.value().value == 42);
+    }
     SECTION("compressed: optional optional int")
     {
         using opt_t = optional_impl<optional_impl<int>>;
@@ -6,6 +6,8 @@
 
 #include <catch.hpp>
 
+#include <foonathan/tiny/optional_impl.hpp>
+
 using namespace foonathan::tiny;
 
 namespace
@@ -94,6 +96,39 @@ namespace
 
         v.reset(static_cast<a_type*>(nullptr));
         verify_null(v);
+
+        // visit
+        struct visitor
+        {
+            std::size_t operator()(std::nullptr_t) const
+            {
+                return 0;
+            }
+            std::size_t operator()(a_type* ptr) const
+            {
+                REQUIRE(ptr == get_pointer<A>::get());
+                return 1;
+            }
+            std::size_t operator()(b_type* ptr) const
+            {
+                REQUIRE(ptr == get_pointer<B>::get());
+                return 2;
+            }
+            std::size_t operator()(c_type* ptr) const
+            {
+                REQUIRE(ptr == get_pointer<C>::get());
+                return 3;
+            }
+        };
+        REQUIRE(v.visit(visitor{}) == 0u);
+        v.reset(a_ptr);
+        REQUIRE(v.visit(visitor{}) == 1u);
+        v.reset(b_ptr);
+        REQUIRE(v.visit(visitor{}) == 2u);
+        v.reset(c_ptr);
+        REQUIRE(v.visit(visitor{}) == 3u);
+        v.reset(static_cast<c_type*>(nullptr));
+        REQUIRE(v.visit(visitor{}) == 0u);
     }
 } // namespace
 
@@ -116,3 +151,47 @@ TEST_CASE("pointer_variant_impl")
         verify_variant_impl<std::int32_t, aligned_obj<char, 4>, aligned_obj<signed char, 8>>(true);
     }
 }
+
+TEST_CASE("pointer_variant_impl tombstones")
+{
+    using variant = pointer_variant_impl<std::int32_t, std::int64_t, const std::uint32_t>;
+    using traits  = tombstone_traits<variant>;
+    // null pointer with the two tag bits
+    REQUIRE(std::size_t(traits::tombstone_count) == 3u);
+
+    traits::storage_type storage;
+    for (auto i = 0u; i != traits::tombstone_count; ++i)
+    {
+        traits::create_tombstone(storage, i);
+        REQUIRE(traits::get_tombstone(storage) == i);
+    }
+
+    auto ptr = reinterpret_cast<std::int64_t*>(std::uintptr_t(1024));
+    traits::create_object(storage, ptr);
+    REQUIRE(traits::get_tombstone(storage) >= std::size_t(traits::tombstone_count));
+    REQUIRE(traits::get_object(storage).pointer_to<std::int64_t>() == ptr);
+
+    // all null pointers are the same
+    traits::get_object(storage).reset(static_cast<std::int64_t*>(nullptr));
+    REQUIRE(traits::get_tombstone(storage) >= std::size_t(traits::tombstone_count));
+    traits::get_object(storage).reset(nullptr);
+    REQUIRE(traits::get_tombstone(storage) >= std::size_t(traits::tombstone_count));
+
+    // additional alignment bits
+    using aligned_variant = pointer_variant_impl<aligned_obj<int, 16>, aligned_obj<char, 16>>;
+    REQUIRE(std::size_t(tombstone_traits<aligned_variant>::tombstone_count) == 15u);
+
+    using opt_t = optional_impl<variant>;
+    REQUIRE(sizeof(opt_t) == sizeof(void*));
+
+    opt_t opt;
+    REQUIRE(!opt.has_value());
+    opt.create_value(nullptr);
+    REQUIRE(opt.has_value());
+    REQUIRE(!opt.value().has_value());
+    opt.value().reset(ptr);
+    REQUIRE(opt.has_value());
+    REQUIRE(opt.value().tag() == 1u);
+    opt.destroy_value();
+    REQUIRE(!opt.has_value());
+}
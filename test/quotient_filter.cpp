@@ -0,0 +1,153 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/quotient_filter.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+template <std::size_t Q, std::size_t R>
+std::vector<std::uint64_t> fingerprints(const quotient_filter<Q, R>& filter)
+{
+    std::vector<std::uint64_t> result;
+    filter.for_each_fingerprint([&](std::uint64_t fp) { result.push_back(fp); });
+    std::sort(result.begin(), result.end());
+    return result;
+}
+} // namespace
+
+TEST_CASE("quotient_filter")
+{
+    using filter_t = quotient_filter<8, 8>;
+    REQUIRE(filter_t::capacity() == 256u);
+    REQUIRE(filter_t::fingerprint_bits() == 16u);
+    // 256 * (3 + 8) bits
+    REQUIRE(sizeof(filter_t) == 352u + sizeof(std::size_t));
+
+    SECTION("basic")
+    {
+        filter_t filter;
+        REQUIRE(filter.empty());
+        REQUIRE(!filter.contains(1001u));
+
+        REQUIRE(filter.insert(1001u));
+        REQUIRE(filter.size() == 1u);
+        REQUIRE(filter.contains(1001u));
+
+        for (auto i = 0u; i != 100u; ++i)
+            REQUIRE(filter.insert(i * 7u));
+        for (auto i = 0u; i != 100u; ++i)
+            REQUIRE(filter.contains(i * 7u));
+        REQUIRE(filter.contains(1001u));
+
+        REQUIRE(filter.insert(1001u));
+        REQUIRE(filter.size() == 102u);
+        // inserted twice, so it needs to be erased twice
+        REQUIRE(filter.erase(1001u));
+        REQUIRE(filter.contains(1001u));
+        REQUIRE(filter.erase(1001u));
+        REQUIRE(!filter.erase(1001u));
+        REQUIRE(filter.size() == 100u);
+
+        for (auto i = 0u; i != 100u; i += 2u)
+            REQUIRE(filter.erase(i * 7u));
+        for (auto i = 1u; i < 100u; i += 2u)
+            REQUIRE(filter.contains(i * 7u));
+        REQUIRE(filter.size() == 50u);
+        REQUIRE(!filter.contains(1001u));
+
+        filter.clear();
+        REQUIRE(filter.empty());
+        REQUIRE(!filter.contains(7u));
+    }
+    SECTION("clusters")
+    {
+        // compare with a sorted vector of fingerprints,
+        // using only a few quotients near the end for long clusters that wrap around
+        std::mt19937                               engine(42u);
+        std::uniform_int_distribution<std::uint64_t> quotient(250u, 260u), remainder(0u, 7u);
+
+        filter_t                   filter;
+        std::vector<std::uint64_t> reference;
+        for (auto i = 0; i != 2000; ++i)
+        {
+            auto fp = ((quotient(engine) % 256u) << 8) | remainder(engine);
+            if (reference.size() < 150u && engine() % 3u != 0u)
+            {
+                REQUIRE(filter.insert_fingerprint(fp));
+                reference.insert(std::upper_bound(reference.begin(), reference.end(), fp), fp);
+            }
+            else
+            {
+                auto iter     = std::lower_bound(reference.begin(), reference.end(), fp);
+                auto expected = iter != reference.end() && *iter == fp;
+                REQUIRE(filter.erase_fingerprint(fp) == expected);
+                if (expected)
+                    reference.erase(iter);
+            }
+
+            REQUIRE(filter.size() == reference.size());
+            REQUIRE(fingerprints(filter) == reference);
+        }
+    }
+    SECTION("full")
+    {
+        filter_t filter;
+        for (auto i = 0u; i != filter.capacity(); ++i)
+            REQUIRE(filter.insert(i));
+        REQUIRE(!filter.insert(1000u));
+        REQUIRE(filter.size() == filter.capacity());
+        for (auto i = 0u; i != filter.capacity(); ++i)
+            REQUIRE(filter.contains(i));
+
+        for (auto i = 0u; i != filter.capacity(); ++i)
+            REQUIRE(filter.erase(i));
+        REQUIRE(filter.empty());
+        REQUIRE(fingerprints(filter).empty());
+    }
+    SECTION("false positives")
+    {
+        filter_t filter;
+        for (auto i = 0u; i != 128u; ++i)
+            filter.insert(i);
+
+        auto false_positives = 0u;
+        for (auto i = 1000u; i != 11000u; ++i)
+            if (filter.contains(i))
+                ++false_positives;
+        // expected: 0.5 * 2^-8 * 10000 = 20
+        REQUIRE(false_positives < 60u);
+    }
+    SECTION("resize and merge")
+    {
+        quotient_filter<6, 10> small;
+        for (auto i = 0u; i != 60u; ++i)
+            small.insert(i);
+
+        quotient_filter<7, 9> big(small);
+        REQUIRE(big.size() == 60u);
+        for (auto i = 0u; i != 60u; ++i)
+            REQUIRE(big.contains(i));
+
+        filter_t other;
+        for (auto i = 100u; i != 150u; ++i)
+            other.insert(i);
+        filter_t merged(big);
+        REQUIRE(merged.merge(other));
+        REQUIRE(merged.size() == 110u);
+        for (auto i = 0u; i != 60u; ++i)
+            REQUIRE(merged.contains(i));
+        for (auto i = 100u; i != 150u; ++i)
+            REQUIRE(merged.contains(i));
+
+        REQUIRE(!small.merge(other));
+    }
+}
@@ -0,0 +1,225 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/rbtree.hpp>
+
+#include <catch.hpp>
+
+#include <algorithm>
+#include <set>
+#include <vector>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+struct element : rbtree_hook
+{
+    int key;
+    int value;
+
+    element(int key, int value = 0) : key(key), value(value) {}
+
+    friend bool operator<(const element& lhs, const element& rhs) noexcept
+    {
+        return lhs.key < rhs.key;
+    }
+};
+
+// allows lookup by key, so the tree works as a map
+struct key_compare
+{
+    bool operator()(const element& lhs, const element& rhs) const noexcept
+    {
+        return lhs.key < rhs.key;
+    }
+    bool operator()(const element& lhs, int rhs) const noexcept
+    {
+        return lhs.key < rhs;
+    }
+    bool operator()(int lhs, const element& rhs) const noexcept
+    {
+        return lhs < rhs.key;
+    }
+};
+
+template <class Tree>
+void verify(const Tree& tree, const std::multiset<int>& reference)
+{
+    REQUIRE(tree.size() == reference.size());
+    REQUIRE(tree.empty() == reference.empty());
+
+    std::vector<int> keys;
+    for (auto& e : tree)
+        keys.push_back(e.key);
+    REQUIRE(keys == std::vector<int>(reference.begin(), reference.end()));
+
+    std::vector<int> reverse_keys;
+    for (auto iter = tree.end(); iter != tree.begin();)
+        reverse_keys.push_back((--iter)->key);
+    REQUIRE(reverse_keys == std::vector<int>(reference.rbegin(), reference.rend()));
+}
+
+// deterministic pseudo random permutation
+std::vector<int> shuffled(int count, unsigned seed)
+{
+    std::vector<int> result;
+    for (auto i = 0; i != count; ++i)
+        result.push_back(i);
+    for (auto i = result.size(); i > 1u; --i)
+    {
+        seed = seed * 1103515245u + 12345u;
+        std::swap(result[i - 1u], result[(seed >> 16) % i]);
+    }
+    return result;
+}
+} // namespace
+
+TEST_CASE("rbtree")
+{
+    // three pointers, the color is in the parent pointer
+    REQUIRE(sizeof(rbtree_hook) == 3 * sizeof(void*));
+
+    SECTION("basic")
+    {
+        rbtree<element> tree;
+        REQUIRE(tree.empty());
+        REQUIRE(tree.begin() == tree.end());
+        verify(tree, {});
+
+        element a(2), b(1), c(3), d(2);
+        REQUIRE(!a.is_linked());
+
+        auto result = tree.insert_unique(a);
+        REQUIRE(result.second);
+        REQUIRE(&*result.first == &a);
+        REQUIRE(a.is_linked());
+
+        REQUIRE(tree.insert_unique(b).second);
+        REQUIRE(tree.insert_unique(c).second);
+        verify(tree, {1, 2, 3});
+
+        result = tree.insert_unique(d);
+        REQUIRE(!result.second);
+        REQUIRE(&*result.first == &a);
+        REQUIRE(!d.is_linked());
+
+        REQUIRE(&*tree.find(element(3)) == &c);
+        REQUIRE(tree.find(element(4)) == tree.end());
+        REQUIRE(&*tree.lower_bound(element(2)) == &a);
+        REQUIRE(&*tree.upper_bound(element(2)) == &c);
+        REQUIRE(tree.upper_bound(element(3)) == tree.end());
+
+        auto next = tree.erase(tree.iterator_to(a));
+        REQUIRE(&*next == &c);
+        REQUIRE(!a.is_linked());
+        verify(tree, {1, 3});
+
+        tree.erase(b);
+        verify(tree, {3});
+
+        tree.clear();
+        REQUIRE(!c.is_linked());
+        verify(tree, {});
+    }
+    SECTION("multiset")
+    {
+        std::vector<element> elements;
+        for (auto i = 0; i != 10; ++i)
+            elements.emplace_back(i % 3, i);
+
+        rbtree<element> tree;
+        for (auto& e : elements)
+            tree.insert_equal(e);
+        verify(tree, {0, 0, 0, 0, 1, 1, 1, 2, 2, 2});
+
+        // equivalent elements are in insertion order
+        std::vector<int> values;
+        for (auto iter = tree.lower_bound(element(1)); iter != tree.upper_bound(element(1));
+             ++iter)
+            values.push_back(iter->value);
+        REQUIRE(values == (std::vector<int>{1, 4, 7}));
+    }
+    SECTION("map")
+    {
+        element a(1, 10), b(2, 20), c(3, 30);
+
+        rbtree<element, key_compare> tree;
+        tree.insert_unique(b);
+        tree.insert_unique(a);
+        tree.insert_unique(c);
+
+        REQUIRE(tree.find(2)->value == 20);
+        REQUIRE(tree.find(4) == tree.end());
+        REQUIRE(tree.lower_bound(0)->value == 10);
+
+        const auto& ctree = tree;
+        REQUIRE(ctree.find(3)->value == 30);
+        REQUIRE(ctree.upper_bound(3) == ctree.end());
+    }
+    SECTION("random")
+    {
+        auto keys = shuffled(1000, 42u);
+
+        std::vector<element> elements(keys.begin(), keys.end());
+        std::multiset<int>   reference;
+
+        rbtree<element> tree;
+        for (auto& e : elements)
+        {
+            REQUIRE(tree.insert_unique(e).second);
+            reference.insert(e.key);
+        }
+        verify(tree, reference);
+
+        for (auto i : shuffled(1000, 7u))
+        {
+            if (i % 3 == 0)
+                continue;
+            tree.erase(elements[std::size_t(i)]);
+            reference.erase(elements[std::size_t(i)].key);
+            if (i % 50 == 0)
+                verify(tree, reference);
+        }
+        verify(tree, reference);
+
+        // reinsert some of them
+        for (auto i = 0; i < 1000; i += 5)
+            if (!elements[std::size_t(i)].is_linked())
+            {
+                tree.insert_equal(elements[std::size_t(i)]);
+                reference.insert(elements[std::size_t(i)].key);
+            }
+        verify(tree, reference);
+
+        // erase everything in order
+        for (auto iter = tree.begin(); iter != tree.end();)
+            iter = tree.erase(iter);
+        verify(tree, {});
+        for (auto& e : elements)
+            REQUIRE(!e.is_linked());
+    }
+    SECTION("move")
+    {
+        element a(1), b(2), c(3);
+
+        rbtree<element> tree;
+        tree.insert_unique(a);
+        tree.insert_unique(b);
+
+        rbtree<element> other(std::move(tree));
+        verify(tree, {});
+        verify(other, {1, 2});
+
+        tree.insert_unique(c);
+        swap(tree, other);
+        verify(tree, {1, 2});
+        verify(other, {3});
+
+        other = std::move(tree);
+        REQUIRE(!c.is_linked());
+        verify(tree, {});
+        verify(other, {1, 2});
+    }
+}
@@ -0,0 +1,157 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/slot_map.hpp>
+
+#include <catch.hpp>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+struct throwing
+{
+    int value;
+
+    throwing(int value) : value(value)
+    {
+        if (value < 0)
+            throw std::runtime_error("negative");
+    }
+};
+} // namespace
+
+TEST_CASE("slot_map")
+{
+    REQUIRE(sizeof(slot_map<int>::handle) == 4u);
+    REQUIRE(sizeof(slot_map<int, 12, 4>::handle) == 2u);
+    REQUIRE(slot_map<int>::max_size() == (1u << 22) - 1u);
+
+    SECTION("basic")
+    {
+        slot_map<std::string> map;
+        REQUIRE(map.empty());
+        REQUIRE(!map.contains(slot_map<std::string>::handle()));
+
+        auto a = map.insert("a");
+        auto b = map.emplace(1u, 'b');
+        auto c = map.insert(std::string("c"));
+        REQUIRE(map.size() == 3u);
+        REQUIRE(a != b);
+        REQUIRE(map[a] == "a");
+        REQUIRE(*map.get(b) == "b");
+        REQUIRE(map[c] == "c");
+
+        REQUIRE(map.erase(a));
+        REQUIRE(!map.contains(a));
+        REQUIRE(map.get(a) == nullptr);
+        REQUIRE(!map.erase(a));
+        REQUIRE(map.size() == 2u);
+        REQUIRE(map[b] == "b");
+        REQUIRE(map[c] == "c");
+
+        // reuses the slot with a new generation
+        auto d = map.insert("d");
+        REQUIRE(d.index() == a.index());
+        REQUIRE(d.generation() == a.generation() + 1u);
+        REQUIRE(!map.contains(a));
+        REQUIRE(map[d] == "d");
+
+        for (auto i = 0u; i != map.size(); ++i)
+            REQUIRE(map[map.handle_at(i)] == *(map.begin() + std::ptrdiff_t(i)));
+
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(!map.contains(b));
+        REQUIRE(!map.contains(c));
+        REQUIRE(!map.contains(d));
+    }
+    SECTION("generation wrap around")
+    {
+        slot_map<int, 4, 2> map;
+        auto                first = map.insert(0);
+        for (auto i = 1; i != 4; ++i)
+        {
+            map.erase(map.handle_at(0));
+            auto h = map.insert(i);
+            REQUIRE(h.index() == first.index());
+            REQUIRE(h.generation() == std::size_t(i));
+        }
+        map.erase(map.handle_at(0));
+        auto h = map.insert(4);
+        REQUIRE(h.generation() == 0u);
+        // handles of the same generation become valid again
+        REQUIRE(map.contains(first));
+    }
+    SECTION("throwing constructor")
+    {
+        slot_map<throwing> map;
+        auto               a = map.emplace(1);
+        auto               b = map.emplace(2);
+        REQUIRE_THROWS(map.emplace(-1));
+        REQUIRE(map.size() == 2u);
+
+        // with a free slot
+        map.erase(a);
+        REQUIRE_THROWS(map.emplace(-1));
+        REQUIRE(map.size() == 1u);
+        REQUIRE(map.handle_at(0u) == b);
+        REQUIRE(map[b].value == 2);
+
+        auto c = map.emplace(3);
+        REQUIRE(c.index() == a.index());
+        REQUIRE(map.size() == 2u);
+        REQUIRE(map[c].value == 3);
+
+        // moves the last element into the hole
+        REQUIRE(map.erase(b));
+        REQUIRE(map.handle_at(0u) == c);
+        REQUIRE(map[c].value == 3);
+
+        // without a free slot
+        auto d = map.emplace(4);
+        REQUIRE_THROWS(map.emplace(-1));
+        auto e = map.emplace(5);
+        REQUIRE(e.index() == 2u);
+        REQUIRE(map.size() == 3u);
+        REQUIRE(map[c].value == 3);
+        REQUIRE(map[d].value == 4);
+        REQUIRE(map[e].value == 5);
+        for (auto i = 0u; i != map.size(); ++i)
+            REQUIRE(map[map.handle_at(i)].value == (map.begin() + std::ptrdiff_t(i))->value);
+    }
+    SECTION("random")
+    {
+        slot_map<int, 10, 6>                        map;
+        std::map<int, slot_map<int, 10, 6>::handle> reference;
+
+        auto seed = 42u;
+        for (auto i = 0; i != 5000; ++i)
+        {
+            seed = seed * 1103515245u + 12345u;
+            if ((seed >> 16) % 3u != 0u && map.size() < 500u)
+                reference[i] = map.insert(i);
+            else if (!reference.empty())
+            {
+                auto iter = reference.lower_bound(int((seed >> 8) % unsigned(i)));
+                if (iter == reference.end())
+                    iter = reference.begin();
+                REQUIRE(map.erase(iter->second));
+                REQUIRE(!map.contains(iter->second));
+                reference.erase(iter);
+            }
+
+            REQUIRE(map.size() == reference.size());
+        }
+
+        for (auto& pair : reference)
+            REQUIRE(map[pair.second] == pair.first);
+        for (auto i = 0u; i != map.size(); ++i)
+            REQUIRE(reference[map[map.handle_at(i)]] == map.handle_at(i));
+    }
+}
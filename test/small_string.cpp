@@ -0,0 +1,120 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/small_string.hpp>
+
+#include <catch.hpp>
+
+#include <string>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+void verify(const small_string& str, const std::string& reference)
+{
+    REQUIRE(str.size() == reference.size());
+    REQUIRE(str.empty() == reference.empty());
+    REQUIRE(str.capacity() >= str.size());
+    REQUIRE(str.is_heap() == (str.size() > str.inline_capacity()));
+    REQUIRE(std::string(str.begin(), str.end()) == reference);
+    REQUIRE(std::string(str.c_str()) == reference);
+}
+} // namespace
+
+TEST_CASE("small_string")
+{
+    REQUIRE(sizeof(small_string) == 3 * sizeof(void*));
+    REQUIRE(small_string::inline_capacity() == 3 * sizeof(void*) - 1u);
+    REQUIRE(is_trivially_relocatable<small_string>::value);
+
+    SECTION("inline")
+    {
+        small_string str;
+        verify(str, "");
+
+        std::string reference;
+        for (auto i = 0u; i != str.inline_capacity(); ++i)
+        {
+            str.push_back(char('a' + i));
+            reference.push_back(char('a' + i));
+            verify(str, reference);
+        }
+        // the last byte is the null terminator
+        REQUIRE(str.data() == reinterpret_cast<const char*>(&str));
+        REQUIRE(str.data()[str.inline_capacity()] == '\0');
+
+        str.pop_back();
+        reference.pop_back();
+        verify(str, reference);
+
+        str[0] = 'A';
+        reference[0] = 'A';
+        verify(str, reference);
+
+        str.clear();
+        verify(str, "");
+    }
+    SECTION("heap")
+    {
+        small_string str("hello");
+        std::string  reference("hello");
+        for (auto i = 0; i != 20; ++i)
+        {
+            str.append(" world");
+            reference.append(" world");
+            verify(str, reference);
+        }
+        REQUIRE(str.is_heap());
+
+        // append part of itself, which requires a reallocation
+        str.reserve(str.size());
+        str.append(str.data(), str.size());
+        reference.append(reference);
+        verify(str, reference);
+
+        str.assign("short", 5u);
+        REQUIRE(str.is_heap());
+        REQUIRE(str.size() == 5u);
+        REQUIRE(std::string(str.c_str()) == "short");
+
+        str.pop_back();
+        REQUIRE(std::string(str.c_str()) == "shor");
+    }
+    SECTION("copy and move")
+    {
+        small_string small("small");
+        small_string big(std::string(100, 'x').c_str());
+
+        auto small_copy = small;
+        verify(small_copy, "small");
+        auto big_copy = big;
+        verify(big_copy, std::string(100, 'x'));
+        REQUIRE(big_copy.data() != big.data());
+
+        auto small_move = std::move(small_copy);
+        verify(small_move, "small");
+        verify(small_copy, "");
+        auto big_move = std::move(big_copy);
+        verify(big_move, std::string(100, 'x'));
+        verify(big_copy, "");
+
+        small_move = std::move(big_move);
+        verify(small_move, std::string(100, 'x'));
+        big_move = small;
+        verify(big_move, "small");
+        small_move = small_move;
+        verify(small_move, std::string(100, 'x'));
+    }
+    SECTION("comparison")
+    {
+        REQUIRE(small_string("abc") == small_string("abc"));
+        REQUIRE(small_string("abc") != small_string("abd"));
+        REQUIRE(small_string("abc") != small_string("ab"));
+        REQUIRE(small_string("ab") < small_string("abc"));
+        REQUIRE(small_string("abc") < small_string("abd"));
+        REQUIRE(!(small_string("abc") < small_string("abc")));
+        REQUIRE(small_string(std::string(30, 'a').c_str()) < small_string("b"));
+    }
+}
@@ -6,6 +6,8 @@
 
 #include <catch.hpp>
 
+#include <foonathan/tiny/optional_impl.hpp>
+
 using namespace foonathan::tiny;
 
 namespace
@@ -89,3 +91,147 @@ TEST_CASE("tagged_union_impl")
     verify_union<C>(cu, 2);
     u.destroy_value<C>();
 }
+
+namespace
+{
+struct index_visitor
+{
+    std::size_t operator()(const A& a) const
+    {
+        a.verify();
+        return 0;
+    }
+    std::size_t operator()(const B& b) const
+    {
+        b.verify();
+        return 1;
+    }
+    std::size_t operator()(const C& c) const
+    {
+        c.verify();
+        return 2;
+    }
+
+    template <typename T, typename U>
+    std::size_t operator()(const T& t, const U& u) const
+    {
+        return (*this)(t) * 3 + (*this)(u);
+    }
+};
+
+struct modify_visitor
+{
+    void operator()(A& a) const
+    {
+        a.i = 43;
+    }
+    template <typename T>
+    void operator()(T&) const
+    {}
+};
+
+struct destroy_visitor
+{
+    template <typename T>
+    void operator()(T& obj) const
+    {
+        obj.~T();
+    }
+};
+
+void create(tagged_union_impl<types>& u, std::size_t index)
+{
+    if (index == 0)
+        u.create_value<A>();
+    else if (index == 1)
+        u.create_value<B>();
+    else
+        u.create_value<C>();
+}
+} // namespace
+
+TEST_CASE("tagged_union_impl visit")
+{
+    tagged_union_impl<types> u;
+    const auto&              cu = u;
+
+    SECTION("single")
+    {
+        u.create_value<A>();
+        REQUIRE(u.visit(index_visitor{}) == 0u);
+        REQUIRE(cu.visit(index_visitor{}) == 0u);
+        REQUIRE(visit(index_visitor{}, u) == 0u);
+
+        u.visit(modify_visitor{});
+        REQUIRE(u.value<A>().i == 43);
+        u.destroy_value<A>();
+
+        u.create_value<B>();
+        REQUIRE(u.visit(index_visitor{}) == 1u);
+        REQUIRE(visit(index_visitor{}, cu) == 1u);
+        u.visit(modify_visitor{});
+        u.destroy_value<B>();
+
+        u.create_value<C>();
+        REQUIRE(u.visit(index_visitor{}) == 2u);
+        REQUIRE(cu.visit(index_visitor{}) == 2u);
+        u.destroy_value<C>();
+    }
+    SECTION("multiple")
+    {
+        tagged_union_impl<types> other;
+        for (auto i = 0u; i != 3u; ++i)
+            for (auto j = 0u; j != 3u; ++j)
+            {
+                create(u, i);
+                create(other, j);
+
+                const auto& cother = other;
+                REQUIRE(visit(index_visitor{}, u, cother) == i * 3 + j);
+                REQUIRE(visit(index_visitor{}, cother, u) == j * 3 + i);
+
+                u.visit(destroy_visitor{});
+                other.visit(destroy_visitor{});
+            }
+    }
+}
+
+TEST_CASE("tagged_union_impl tombstones")
+{
+    using traits = tombstone_traits<tagged_union_impl<types>>;
+    // two bits for three types
+    REQUIRE(std::size_t(traits::tombstone_count) == 1u);
+
+    traits::storage_type storage;
+    traits::create_tombstone(storage, 0u);
+    REQUIRE(traits::get_tombstone(storage) == 0u);
+
+    traits::create_object(storage);
+    REQUIRE(traits::get_tombstone(storage) >= std::size_t(traits::tombstone_count));
+    for (auto i = 0u; i != 3u; ++i)
+    {
+        create(traits::get_object(storage), i);
+        REQUIRE(traits::get_tombstone(storage) >= std::size_t(traits::tombstone_count));
+        REQUIRE(traits::get_object(storage).tag() == i);
+        traits::get_object(storage).visit(destroy_visitor{});
+    }
+    traits::destroy_object(storage);
+
+    using opt_t = optional_impl<tagged_union_impl<types>>;
+    REQUIRE(sizeof(opt_t) == sizeof(tagged_union_impl<types>));
+
+    opt_t opt;
+    REQUIRE(!opt.has_value());
+    opt.create_value();
+    REQUIRE(opt.has_value());
+    opt.value().create_value<B>();
+    REQUIRE(opt.has_value());
+    verify_union<B>(opt.value(), 1);
+    opt.value().destroy_value<B>();
+    opt.destroy_value();
+    REQUIRE(!opt.has_value());
+
+    // all encodings are used
+    using full_traits = tombstone_traits<tagged_union_impl<union_types<A, B, C, int>>>;
+    REQUIRE(std::size_t(full_traits::tombstone_count) == 0u);
+}
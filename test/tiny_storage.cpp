@@ -7,7 +7,10 @@
 #include <catch.hpp>
 
 #include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_enum.hpp>
+#include <foonathan/tiny/tiny_fixed.hpp>
 #include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_optional.hpp>
 
 using namespace foonathan::tiny;
 
@@ -54,4 +57,54 @@ TEST_CASE("tiny_storage")
         storage s;
         REQUIRE(s.spare_bits().size() == CHAR_BIT);
     }
+    SECTION("optional")
+    {
+        enum class e
+        {
+            a,
+            b,
+            c,
+            _unsigned_count,
+        };
+        using storage_t
+            = tiny_storage<tiny_optional<tiny_int_range<0, 5>>, tiny_optional<tiny_enum<e>>, tiny_bool>;
+        REQUIRE(sizeof(storage_t) == 1u);
+
+        storage_t s;
+        REQUIRE(!s.at<0>().has_value());
+        REQUIRE(!s.at<1>().has_value());
+        REQUIRE(!s.at<2>());
+
+        s.at<0>() = 3;
+        s.at<2>() = true;
+        REQUIRE(s.at<0>().has_value());
+        REQUIRE(s.at<0>() == 3);
+        REQUIRE(!s.at<1>().has_value());
+        REQUIRE(s.at<2>());
+
+        s.at<1>() = e::b;
+        REQUIRE(s.at<1>().has_value());
+        REQUIRE(s.at<1>() == e::b);
+
+        s.at<0>().reset();
+        REQUIRE(!s.at<0>().has_value());
+        REQUIRE(s.at<1>() == e::b);
+    }
+    SECTION("fixed")
+    {
+        using storage_t = tiny_storage<tiny_ufixed<1, 11>, tiny_fixed<2, 2>>;
+        REQUIRE(sizeof(storage_t) == 2u);
+
+        storage_t s(0.75, -1.25);
+        REQUIRE(s.at<0>() == 0.75);
+        REQUIRE(s.at<1>() == -1.25);
+
+        s.at<1>() = 1.5;
+        s.at<0>() *= s.at<1>();
+        REQUIRE(s.at<0>() == 1.125);
+        s.at<0>() = 0.5;
+        s.at<0>() += s.at<0>();
+        REQUIRE(s.at<0>() == 1.);
+        REQUIRE(s.at<1>() == 1.5);
+    }
 }
@@ -6,10 +6,16 @@
 
 #include <catch.hpp>
 
+#include <random>
+
+#include <foonathan/tiny/tiny_approx_counter.hpp>
 #include <foonathan/tiny/tiny_bool.hpp>
 #include <foonathan/tiny/tiny_enum.hpp>
+#include <foonathan/tiny/tiny_fixed.hpp>
 #include <foonathan/tiny/tiny_flag_set.hpp>
+#include <foonathan/tiny/tiny_float.hpp>
 #include <foonathan/tiny/tiny_int.hpp>
+#include <foonathan/tiny/tiny_optional.hpp>
 
 using namespace foonathan::tiny;
 
@@ -49,8 +55,117 @@ void verify_bool(Proxy proxy, bool value)
     REQUIRE_FALSE(proxy != value);
     REQUIRE_FALSE(value != proxy);
 }
+// how often the exponent is incremented in 100000 tries
+template <class Rng>
+int count_increments(unsigned exponent, Rng& rng)
+{
+    using type = tiny_approx_counter<13, std::ratio<1001, 1000>>;
+
+    tiny_storage storage = 0;
+    auto         proxy   = make_proxy<type>(storage);
+
+    auto result = 0;
+    for (auto i = 0; i != 100000; ++i)
+    {
+        proxy = exponent;
+        if (proxy.increment(rng))
+            ++result;
+    }
+    return result;
+}
 } // namespace
 
+TEST_CASE("tiny_approx_counter")
+{
+    SECTION("base 2")
+    {
+        using type = tiny_approx_counter<4>;
+        REQUIRE(type::bit_size() == 4u);
+        REQUIRE(type::max_exponent() == 15u);
+        REQUIRE(type::estimate(0u) == 0.);
+        REQUIRE(type::estimate(1u) == 1.);
+        REQUIRE(type::estimate(2u) == 3.);
+        REQUIRE(type::estimate(15u) == 32767.);
+
+        tiny_storage storage = 0;
+        auto         cproxy  = make_cproxy<type>(storage);
+        REQUIRE(cproxy == 0u);
+        REQUIRE(cproxy.estimate() == 0.);
+
+        xorshift_engine engine(42u);
+        auto            proxy = make_proxy<type>(storage);
+        // the first increment always counts
+        REQUIRE(proxy.increment(engine));
+        REQUIRE(proxy == 1u);
+        REQUIRE(proxy.estimate() == 1.);
+
+        proxy = 14u;
+        REQUIRE(proxy.estimate() == 16383.);
+        while (!proxy.increment(engine))
+        {
+        }
+        REQUIRE(proxy == 15u);
+
+        // saturated
+        for (auto i = 0; i != 100; ++i)
+            REQUIRE(!proxy.increment(engine));
+        REQUIRE(proxy == 15u);
+
+        proxy.reset();
+        REQUIRE(proxy == 0u);
+        REQUIRE(storage == 0);
+
+        proxy.increment();
+        REQUIRE(proxy == 1u);
+    }
+    SECTION("accuracy")
+    {
+        using type = tiny_approx_counter<8, std::ratio<11, 10>>;
+
+        xorshift_engine engine(1234u);
+        auto            sum = 0.;
+        for (auto counter = 0; counter != 100; ++counter)
+        {
+            tiny_storage storage = 0;
+            auto         proxy   = make_proxy<type>(storage);
+            for (auto i = 0; i != 10000; ++i)
+                proxy.increment(engine);
+            sum += proxy.estimate();
+        }
+
+        auto mean = sum / 100;
+        REQUIRE(mean > 9000.);
+        REQUIRE(mean < 11000.);
+    }
+    SECTION("probability")
+    {
+        // 1.001^-1000 = 0.368, from the table
+        xorshift_engine engine(42u);
+        auto            table = count_increments(1000u, engine);
+        REQUIRE(table > 35800);
+        REQUIRE(table < 37800);
+
+        // 1.001^-5000 = 0.00673, computed
+        auto computed = count_increments(5000u, engine);
+        REQUIRE(computed > 570);
+        REQUIRE(computed < 780);
+
+        // a generator with 32 bits
+        std::mt19937 mt;
+        auto         narrow = count_increments(1000u, mt);
+        REQUIRE(narrow > 35800);
+        REQUIRE(narrow < 37800);
+    }
+    SECTION("noexcept")
+    {
+        tiny_storage    storage = 0;
+        auto            proxy   = make_proxy<tiny_approx_counter<4>>(storage);
+        xorshift_engine engine;
+        REQUIRE(noexcept(proxy.increment()));
+        REQUIRE(noexcept(proxy.increment(engine)));
+    }
+}
+
 TEST_CASE("tiny_bool")
 {
     tiny_storage storage = 0;
@@ -111,6 +226,105 @@ TEST_CASE("tiny_enum")
     verify_enum(proxy, e::d);
 }
 
+namespace
+{
+enum class wire : std::uint8_t
+{
+    hello   = 1,
+    data    = 2,
+    ack     = 4,
+    goodbye = 200,
+};
+
+enum class wide : std::int32_t
+{
+    min   = -1000000,
+    zero  = 0,
+    large = 1 << 30,
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct enum_traits<wire>
+    : enum_traits_sparse<wire, wire::hello, wire::data, wire::ack, wire::goodbye>
+    {};
+
+    template <>
+    struct enum_traits<wide> : enum_traits_sparse<wide, wide::min, wide::zero, wide::large>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("tiny_enum sparse")
+{
+    SECTION("traits")
+    {
+        // table lookup
+        using traits = enum_traits<wire>;
+        REQUIRE(traits::min() == wire::hello);
+        REQUIRE(traits::max() == wire::goodbye);
+        REQUIRE(enum_size<wire>() == 4u);
+        REQUIRE(enum_bit_size<wire>() == 2u);
+
+        REQUIRE(traits::index_of(wire::hello) == 0u);
+        REQUIRE(traits::index_of(wire::data) == 1u);
+        REQUIRE(traits::index_of(wire::ack) == 2u);
+        REQUIRE(traits::index_of(wire::goodbye) == 3u);
+        REQUIRE(traits::index_of(wire(0)) == 4u);
+        REQUIRE(traits::index_of(wire(3)) == 4u);
+        REQUIRE(traits::index_of(wire(199)) == 4u);
+        REQUIRE(traits::index_of(wire(255)) == 4u);
+
+        REQUIRE(is_valid_enum_value(wire::ack));
+        REQUIRE(!is_valid_enum_value(wire(3)));
+
+        // binary search
+        using wide_traits = enum_traits<wide>;
+        REQUIRE(enum_bit_size<wide>() == 2u);
+        REQUIRE(wide_traits::index_of(wide::min) == 0u);
+        REQUIRE(wide_traits::index_of(wide::zero) == 1u);
+        REQUIRE(wide_traits::index_of(wide::large) == 2u);
+        REQUIRE(wide_traits::index_of(wide(-1000001)) == 3u);
+        REQUIRE(wide_traits::index_of(wide(1)) == 3u);
+        REQUIRE(wide_traits::index_of(wide((1 << 30) + 1)) == 3u);
+        REQUIRE(wide_traits::value_at(1u) == wide::zero);
+    }
+    SECTION("tiny type")
+    {
+        using type = tiny_enum<wire>;
+        REQUIRE(type::bit_size() == 2u);
+        REQUIRE(tiny_max_encoding<type>() == 3u);
+
+        tiny_storage storage = 0;
+        auto         cproxy  = make_cproxy<type>(storage);
+        verify_enum(cproxy, wire::hello);
+
+        auto proxy = make_proxy<type>(storage);
+        proxy      = wire::goodbye;
+        verify_enum(proxy, wire::goodbye);
+        REQUIRE(storage == 3);
+
+        proxy = wire::ack;
+        verify_enum(proxy, wire::ack);
+
+        proxy = wire::data;
+        verify_enum(proxy, wire::data);
+
+        using wide_type = tiny_enum<wide>;
+        REQUIRE(tiny_max_encoding<wide_type>() == 2u);
+
+        auto wide_proxy = make_proxy<wide_type>(storage);
+        wide_proxy      = wide::min;
+        verify_enum(wide_proxy, wide::min);
+        wide_proxy = wide::large;
+        verify_enum(wide_proxy, wide::large);
+    }
+}
+
 namespace
 {
 template <class Proxy, class Int>
@@ -363,6 +577,292 @@ TEST_CASE("tiny_int_range")
     }
 }
 
+TEST_CASE("tiny_fixed")
+{
+    SECTION("unsigned")
+    {
+        using type = tiny_ufixed<2, 10>;
+        REQUIRE(type::bit_size() == 12u);
+        REQUIRE(type::min() == 0.);
+        REQUIRE(type::max() == 4. - 1. / 1024.);
+        REQUIRE(type::epsilon() == 1. / 1024.);
+
+        tiny_storage storage = 0;
+        auto         cproxy  = make_cproxy<type>(storage);
+        REQUIRE(cproxy == 0.);
+
+        auto proxy = make_proxy<type>(storage);
+        proxy      = 1.5;
+        REQUIRE(proxy == 1.5);
+        REQUIRE(proxy.raw() == 1536);
+        REQUIRE(storage == 1536);
+
+        // rounded to nearest
+        proxy = 0.1;
+        REQUIRE(proxy.raw() == 102);
+        proxy = 1. / 2048.;
+        REQUIRE(proxy.raw() == 1);
+
+        proxy.set_raw(4095);
+        REQUIRE(proxy == type::max());
+
+        // arithmetic
+        proxy = 1.25;
+        proxy += 0.5;
+        REQUIRE(proxy == 1.75);
+        proxy -= 1.;
+        REQUIRE(proxy == 0.75);
+        proxy *= 3.;
+        REQUIRE(proxy == 2.25);
+        proxy *= 0.5;
+        REQUIRE(proxy == 1.125);
+
+        tiny_storage other_storage = 0;
+        auto         other         = make_proxy<type>(other_storage);
+        other                      = 2.;
+        proxy += other;
+        REQUIRE(proxy == 3.125);
+        proxy -= other;
+        REQUIRE(proxy == 1.125);
+        proxy *= other;
+        REQUIRE(proxy == 2.25);
+
+        // rescaling the product rounds
+        proxy.set_raw(3);
+        other.set_raw(512);
+        proxy *= other;
+        REQUIRE(proxy.raw() == 2);
+    }
+    SECTION("signed")
+    {
+        using type = tiny_fixed<3, 4>;
+        REQUIRE(type::bit_size() == 7u);
+        REQUIRE(type::min() == -4.);
+        REQUIRE(type::max() == 4. - 1. / 16.);
+
+        tiny_storage storage = 0;
+        auto         proxy   = make_proxy<type>(storage);
+        REQUIRE(proxy == 0.);
+
+        proxy = -1.5;
+        REQUIRE(proxy == -1.5);
+        REQUIRE(proxy.raw() == -24);
+
+        proxy = -4.;
+        REQUIRE(proxy == -4.);
+        proxy = 3.9375;
+        REQUIRE(proxy == 3.9375);
+
+        // ties away from zero
+        proxy = -1. / 32.;
+        REQUIRE(proxy.raw() == -1);
+
+        proxy = -0.5;
+        proxy *= -2.;
+        REQUIRE(proxy == 1.);
+        proxy -= 2.5;
+        REQUIRE(proxy == -1.5);
+
+        proxy.set_raw(-3);
+        tiny_storage half_storage = 0;
+        auto         half         = make_proxy<type>(half_storage);
+        half                      = 0.5;
+        proxy *= half;
+        REQUIRE(proxy.raw() == -2);
+    }
+    SECTION("rounding")
+    {
+        tiny_storage storage = 0;
+
+        auto zero = make_proxy<tiny_fixed<3, 2, double, fixed_rounding::toward_zero>>(storage);
+        zero      = 1.2;
+        REQUIRE(zero == 1.);
+        zero = -1.2;
+        REQUIRE(zero == -1.);
+
+        auto down = make_proxy<tiny_fixed<3, 2, double, fixed_rounding::down>>(storage);
+        down      = 1.2;
+        REQUIRE(down == 1.);
+        down = -1.2;
+        REQUIRE(down == -1.25);
+        down.set_raw(-3);
+        down *= 0.5;
+        REQUIRE(down.raw() == -2);
+
+        auto up = make_proxy<tiny_fixed<3, 2, float, fixed_rounding::up>>(storage);
+        up      = 1.2f;
+        REQUIRE(up == 1.25f);
+        up = -1.2f;
+        REQUIRE(up == -1.f);
+        up.set_raw(3);
+        up *= 0.5f;
+        REQUIRE(up.raw() == 2);
+    }
+}
+
+TEST_CASE("tiny_float")
+{
+    SECTION("IEEE style 1-4-3")
+    {
+        using type = tiny_float<4, 3>;
+        REQUIRE(type::bit_size() == 8u);
+        REQUIRE(type::max() == 240.f);
+        REQUIRE(type::min() == 1.f / 64.f);
+        REQUIRE(type::denorm_min() == 1.f / 512.f);
+
+        // every encoding is converted exactly
+        for (auto i = 0u; i != 256u; ++i)
+        {
+            auto encoding = static_cast<type::encoding_type>(i);
+            auto value    = type::decode(encoding);
+            if (value != value)
+                // NaNs become the quiet NaN
+                REQUIRE(type::encode(value) == ((encoding & 0x80u) | 0x7Cu));
+            else
+                REQUIRE(type::encode(value) == encoding);
+        }
+
+        REQUIRE(type::encode(1.f) == 0x38u);
+        REQUIRE(type::encode(-2.f) == 0xC0u);
+        REQUIRE(type::encode(0.f) == 0x00u);
+        REQUIRE(type::encode(-0.f) == 0x80u);
+
+        // ties to even
+        REQUIRE(type::decode(type::encode(1.0625f)) == 1.f);
+        REQUIRE(type::decode(type::encode(1.1875f)) == 1.25f);
+        REQUIRE(type::decode(type::encode(1.07f)) == 1.125f);
+        REQUIRE(type::decode(type::encode(-1.07f)) == -1.125f);
+        // rounding up carries into the exponent
+        REQUIRE(type::decode(type::encode(1.95f)) == 2.f);
+
+        // subnormals
+        REQUIRE(type::decode(type::encode(3.f / 512.f)) == 3.f / 512.f);
+        REQUIRE(type::decode(type::encode(1.f / 1024.f)) == 0.f);
+        REQUIRE(type::decode(type::encode(3.f / 2048.f)) == 1.f / 512.f);
+        REQUIRE(type::decode(type::encode(15.5f / 1024.f)) == 1.f / 64.f);
+        REQUIRE(type::decode(type::encode(1e-30f)) == 0.f);
+        REQUIRE(type::decode(type::encode(std::numeric_limits<float>::denorm_min())) == 0.f);
+
+        // saturation
+        REQUIRE(type::decode(type::encode(247.f)) == 240.f);
+        REQUIRE(type::decode(type::encode(1e30f)) == 240.f);
+        REQUIRE(type::decode(type::encode(-1e30f)) == -240.f);
+
+        // infinity and NaN
+        auto inf = std::numeric_limits<float>::infinity();
+        REQUIRE(type::decode(type::encode(inf)) == inf);
+        REQUIRE(type::decode(type::encode(-inf)) == -inf);
+        auto nan = type::decode(type::encode(std::numeric_limits<float>::quiet_NaN()));
+        REQUIRE(nan != nan);
+    }
+    SECTION("E4M3FN")
+    {
+        using type = tiny_float<4, 3, float_layout::finite>;
+        REQUIRE(type::bit_size() == 8u);
+        REQUIRE(type::max() == 448.f);
+        REQUIRE(type::min() == 1.f / 64.f);
+        REQUIRE(type::denorm_min() == 1.f / 512.f);
+
+        // every encoding is converted exactly, only S.1111.111 is NaN
+        for (auto i = 0u; i != 256u; ++i)
+        {
+            auto encoding = static_cast<type::encoding_type>(i);
+            auto value    = type::decode(encoding);
+            REQUIRE((value != value) == ((i & 0x7Fu) == 0x7Fu));
+            REQUIRE(type::encode(value) == encoding);
+        }
+
+        REQUIRE(type::encode(1.f) == 0x38u);
+        REQUIRE(type::encode(240.f) == 0x77u);
+        REQUIRE(type::encode(256.f) == 0x78u);
+        REQUIRE(type::encode(448.f) == 0x7Eu);
+        REQUIRE(type::encode(-448.f) == 0xFEu);
+
+        // saturation, ties to even would round 464 down anyway
+        REQUIRE(type::decode(type::encode(464.f)) == 448.f);
+        REQUIRE(type::decode(type::encode(480.f)) == 448.f);
+        REQUIRE(type::decode(type::encode(1e30f)) == 448.f);
+        REQUIRE(type::decode(type::encode(-1e30f)) == -448.f);
+
+        // no infinity
+        auto inf = std::numeric_limits<float>::infinity();
+        REQUIRE(type::encode(inf) == 0x7Eu);
+        REQUIRE(type::encode(-inf) == 0xFEu);
+        REQUIRE(type::encode(std::numeric_limits<float>::quiet_NaN()) == 0x7Fu);
+    }
+    SECTION("half")
+    {
+        using type = tiny_float<5, 10>;
+        REQUIRE(type::bit_size() == 16u);
+        REQUIRE(type::max() == 65504.f);
+
+        REQUIRE(type::encode(1.f) == 0x3C00u);
+        REQUIRE(type::encode(-2.5f) == 0xC100u);
+        REQUIRE(type::encode(65504.f) == 0x7BFFu);
+        REQUIRE(type::encode(70000.f) == 0x7BFFu);
+        REQUIRE(type::encode(std::numeric_limits<float>::infinity()) == 0x7C00u);
+        REQUIRE(type::encode(5.9604645e-8f) == 0x0001u);
+        REQUIRE(type::encode(0.333333343f) == 0x3555u);
+    }
+    SECTION("bfloat")
+    {
+        using type = tiny_float<8, 7>;
+        REQUIRE(type::bit_size() == 16u);
+
+        // compare with the usual rounding of the upper half of the bits
+        for (auto f : {1.f, 3.14159265f, -2.71828f, 1e-20f, 1e20f, 1.00390625f, 1.01171875f,
+                       std::numeric_limits<float>::denorm_min(), std::numeric_limits<float>::min(),
+                       -std::numeric_limits<float>::min() * 0.75f})
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &f, sizeof(bits));
+            auto expected = (bits + 0x7FFFu + ((bits >> 16) & 1u)) >> 16;
+            REQUIRE(type::encode(f) == expected);
+
+            auto decoded = type::decode(type::encode(f));
+            std::memcpy(&bits, &decoded, sizeof(bits));
+            REQUIRE(bits == expected << 16);
+        }
+        REQUIRE(type::encode(std::numeric_limits<float>::max()) == 0x7F7Fu);
+    }
+    SECTION("bulk")
+    {
+        using type = tiny_float<5, 2>;
+
+        float              values[] = {0.f, 1.f, -1.5f, 100.f, 1e10f, 1.f / 32768.f};
+        type::encoding_type encodings[6];
+        type::encode(values, 6u, encodings);
+        for (auto i = 0u; i != 6u; ++i)
+            REQUIRE(encodings[i] == type::encode(values[i]));
+
+        float decoded[6];
+        type::decode(encodings, 6u, decoded);
+        REQUIRE(decoded[0] == 0.f);
+        REQUIRE(decoded[1] == 1.f);
+        REQUIRE(decoded[2] == -1.5f);
+        REQUIRE(decoded[3] == 96.f);
+        REQUIRE(decoded[4] == type::max());
+        REQUIRE(decoded[5] == 1.f / 32768.f);
+    }
+    SECTION("proxy")
+    {
+        tiny_storage storage = 0;
+
+        auto cproxy = make_cproxy<tiny_float<4, 3>>(storage);
+        REQUIRE(cproxy == 0.f);
+
+        auto proxy = make_proxy<tiny_float<4, 3>>(storage);
+        proxy      = 0.75f;
+        REQUIRE(proxy == 0.75f);
+        REQUIRE(proxy.encoding() == 0x34u);
+        REQUIRE(storage == 0x34);
+
+        proxy = -300.f;
+        REQUIRE(proxy == -240.f);
+        REQUIRE(storage == 0xF7);
+    }
+}
+
 namespace
 {
 enum class test_flags
@@ -461,3 +961,75 @@ TEST_CASE("tiny_flag_set")
         }
     }
 }
+
+TEST_CASE("tiny_max_encoding")
+{
+    enum class e
+    {
+        a,
+        b,
+        c,
+        _unsigned_count,
+    };
+
+    REQUIRE(tiny_max_encoding<tiny_bool>() == 1u);
+    REQUIRE(tiny_max_encoding<tiny_unsigned<4>>() == 15u);
+    REQUIRE(tiny_max_encoding<tiny_int<4>>() == 15u);
+    REQUIRE(tiny_max_encoding<tiny_unsigned<64, std::uint64_t>>() == std::uintmax_t(-1));
+    REQUIRE(tiny_max_encoding<tiny_enum<e>>() == 2u);
+
+    REQUIRE(tiny_int_range<0, 5>::bit_size() == 3u);
+    REQUIRE(tiny_max_encoding<tiny_int_range<0, 5>>() == 5u);
+    REQUIRE(tiny_int_range<0, 4>::bit_size() == 3u);
+    REQUIRE(tiny_int_range<0, 3>::bit_size() == 2u);
+    REQUIRE(tiny_int_range<-10, 10>::bit_size() == 5u);
+    REQUIRE(tiny_max_encoding<tiny_int_range<-10, 10>>() == 20u);
+}
+
+TEST_CASE("tiny_optional")
+{
+    enum class e
+    {
+        a,
+        b,
+        c,
+        _unsigned_count,
+    };
+    using type = tiny_optional<tiny_enum<e>>;
+    REQUIRE(type::bit_size() == 2u);
+    REQUIRE(tiny_max_encoding<type>() == 3u);
+
+    tiny_storage storage = 0;
+
+    auto cproxy = make_cproxy<type>(storage);
+    REQUIRE(!cproxy.has_value());
+
+    auto proxy = make_proxy<type>(storage);
+    REQUIRE(!proxy.has_value());
+
+    proxy = e::a;
+    REQUIRE(proxy.has_value());
+    REQUIRE(cproxy.has_value());
+    verify_enum(proxy, e::a);
+
+    proxy = e::c;
+    REQUIRE(proxy.has_value());
+    REQUIRE(proxy.value() == e::c);
+    verify_enum(cproxy, e::c);
+
+    proxy.reset();
+    REQUIRE(!proxy.has_value());
+
+    SECTION("nested")
+    {
+        using nested = tiny_optional<tiny_optional<tiny_int_range<0, 5>>>;
+        REQUIRE(nested::bit_size() == 3u);
+
+        auto nested_proxy = make_proxy<nested>(storage);
+        REQUIRE(!nested_proxy.has_value());
+
+        nested_proxy = 5;
+        REQUIRE(nested_proxy.has_value());
+        REQUIRE(nested_proxy.value() == 5);
+    }
+}
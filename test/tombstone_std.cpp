@@ -0,0 +1,120 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/tombstone_std.hpp>
+
+#include <catch.hpp>
+
+#include <foonathan/tiny/optional_impl.hpp>
+
+using namespace foonathan::tiny;
+
+#if FOONATHAN_TINY_STD_TOMBSTONES
+
+namespace
+{
+template <typename T>
+void verify_tombstones(std::size_t min_count)
+{
+    using traits = tombstone_traits<T>;
+    REQUIRE(std::size_t(traits::tombstone_count) >= min_count);
+
+    typename traits::storage_type storage;
+    for (auto i : {std::size_t(0), std::size_t(1), min_count - 1u})
+    {
+        traits::create_tombstone(storage, i);
+        REQUIRE(traits::get_tombstone(storage) == i);
+    }
+}
+
+template <typename T>
+void verify_object(T obj)
+{
+    using traits = tombstone_traits<T>;
+
+    typename traits::storage_type storage;
+    traits::create_object(storage, std::move(obj));
+    REQUIRE(traits::get_tombstone(storage) >= std::size_t(traits::tombstone_count));
+
+    // moved-from objects aren't tombstones either
+    T moved(std::move(traits::get_object(storage)));
+    REQUIRE(traits::get_tombstone(storage) >= std::size_t(traits::tombstone_count));
+    traits::destroy_object(storage);
+}
+
+template <typename T>
+void verify_optional(T obj)
+{
+    using opt_t = optional_impl<T>;
+    REQUIRE(opt_t::is_compressed::value);
+    REQUIRE(sizeof(opt_t) == sizeof(T));
+
+    opt_t opt;
+    REQUIRE(!opt.has_value());
+    opt.create_value(obj);
+    REQUIRE(opt.has_value());
+    REQUIRE(opt.value() == obj);
+    opt.destroy_value();
+    REQUIRE(!opt.has_value());
+}
+} // namespace
+
+TEST_CASE("tombstone_traits std::unique_ptr")
+{
+    using ptr = std::unique_ptr<int>;
+    verify_tombstones<ptr>(alignof(int) - 1u);
+    verify_object(ptr());
+    verify_object(ptr(new int(42)));
+
+    optional_impl<ptr> opt;
+    REQUIRE(sizeof(opt) == sizeof(ptr));
+    opt.create_value(new int(42));
+    REQUIRE(opt.has_value());
+    REQUIRE(*opt.value() == 42);
+    opt.destroy_value();
+    REQUIRE(!opt.has_value());
+}
+
+TEST_CASE("tombstone_traits std::vector")
+{
+    using vec = std::vector<int>;
+    verify_tombstones<vec>(1024u);
+    verify_object(vec());
+    verify_object(vec{1, 2, 3});
+
+    vec reserved;
+    reserved.reserve(16u);
+    verify_object(reserved);
+
+    verify_optional(vec{1, 2, 3});
+    verify_optional(std::vector<std::string>{"a", "b"});
+}
+
+#    if !defined(__GLIBCXX__) || _GLIBCXX_USE_CXX11_ABI
+TEST_CASE("tombstone_traits std::string")
+{
+    verify_tombstones<std::string>(1024u);
+    verify_object(std::string());
+    verify_object(std::string("short"));
+    verify_object(std::string(100u, 'a'));
+
+    verify_optional(std::string());
+    verify_optional(std::string("short"));
+    verify_optional(std::string(100u, 'a'));
+}
+#    endif
+
+#    if __cplusplus >= 201703L
+TEST_CASE("tombstone_traits std::string_view")
+{
+    verify_tombstones<std::string_view>(1024u);
+    verify_object(std::string_view());
+    verify_object(std::string_view("Hello World!"));
+    verify_object(std::string_view("Hello World!", 0u));
+
+    verify_optional(std::string_view("Hello World!"));
+}
+#    endif
+
+#endif
@@ -6,8 +6,13 @@
 
 #include <catch.hpp>
 
+#include <cmath>
+#include <cstring>
+
 #include <foonathan/tiny/optional_impl.hpp>
+#include <foonathan/tiny/padding_tiny_storage.hpp>
 #include <foonathan/tiny/pointer_tiny_storage.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
 #include <foonathan/tiny/tiny_enum.hpp>
 
 using namespace foonathan::tiny;
@@ -190,6 +195,87 @@ TEST_CASE("tombstone_traits padded")
     }
 }
 
+namespace
+{
+struct pointer_and_int
+{
+    int* p;
+    int  x;
+
+    friend bool operator==(pointer_and_int lhs, pointer_and_int rhs)
+    {
+        return lhs.p == rhs.p && lhs.x == rhs.x;
+    }
+};
+
+struct int_and_bool
+{
+    int  x;
+    bool b;
+
+    friend bool operator==(int_and_bool lhs, int_and_bool rhs)
+    {
+        return lhs.x == rhs.x && lhs.b == rhs.b;
+    }
+};
+
+struct with_string
+{
+    std::string str;
+    bool        b;
+
+    friend bool operator==(const with_string& lhs, const with_string& rhs)
+    {
+        return lhs.str == rhs.str && lhs.b == rhs.b;
+    }
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct tombstone_traits<pointer_and_int>
+    : tombstone_traits_member<pointer_and_int, FOONATHAN_TINY_MEMBER(pointer_and_int, p)>
+    {};
+
+    template <>
+    struct tombstone_traits<int_and_bool>
+    : tombstone_traits_member<int_and_bool, FOONATHAN_TINY_MEMBER(int_and_bool, b)>
+    {};
+
+    template <>
+    struct tombstone_traits<with_string>
+    : tombstone_traits_member<with_string, FOONATHAN_TINY_MEMBER(with_string, b)>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("tombstone_traits_member")
+{
+    SECTION("pointer")
+    {
+        verify_tombstones<pointer_and_int>(alignof(int) - 1u);
+
+        int i;
+        verify_object(pointer_and_int{&i, 42});
+        verify_object(pointer_and_int{nullptr, -1});
+    }
+    SECTION("member not at the beginning")
+    {
+        verify_tombstones<int_and_bool>(127);
+        verify_object(int_and_bool{0, false});
+        verify_object(int_and_bool{42, true});
+    }
+    SECTION("non-trivial")
+    {
+        verify_tombstones<with_string>(127);
+        verify_object(with_string{"hello", false});
+        verify_object(with_string{"", true});
+    }
+}
+
 TEST_CASE("tombstone_traits tiny")
 {
     SECTION("bool")
@@ -200,9 +286,26 @@ TEST_CASE("tombstone_traits tiny")
     }
     SECTION("tiny_int")
     {
-        verify_tombstones<tiny_unsigned<4>>(15);
+        verify_tombstones<tiny_unsigned<4>>(240);
         for (auto i = 0u; i != 16; ++i)
             verify_object<tiny_unsigned<4>>(i);
+
+        verify_tombstones<tiny_unsigned<8>>(0);
+        verify_tombstones<tiny_unsigned<12>>(65535 - 4095);
+        for (auto i : {0u, 1u, 4095u})
+            verify_object<tiny_unsigned<12>>(i);
+    }
+    SECTION("tiny_int_range")
+    {
+        // 3 bits, but only 6 encodings used
+        using type = tiny_int_range<0, 5>;
+        verify_tombstones<type>(250);
+        for (auto i = 0; i <= 5; ++i)
+            verify_object<type>(i);
+
+        verify_tombstones<tiny_int_range<-5, 5>>(245);
+        for (auto i = -5; i <= 5; ++i)
+            verify_object<tiny_int_range<-5, 5>>(i);
     }
     SECTION("enum")
     {
@@ -214,13 +317,208 @@ TEST_CASE("tombstone_traits tiny")
             unsigned_count_,
         };
 
-        verify_tombstones<tiny_enum<foo>>(63);
+        verify_tombstones<tiny_enum<foo>>(253);
         verify_object<tiny_enum<foo>>(foo::a);
         verify_object<tiny_enum<foo>>(foo::b);
         verify_object<tiny_enum<foo>>(foo::c);
     }
 }
 
+namespace
+{
+enum class small_enum : unsigned char
+{
+    a,
+    b,
+    c,
+    _unsigned_count,
+};
+
+enum class signed_enum : signed char
+{
+    a = -3,
+    b = 0,
+    c = 5,
+};
+
+enum class full_enum : unsigned char
+{
+    _unsigned_max = 255,
+};
+
+enum class int_enum
+{
+    a,
+    b,
+    _unsigned_count,
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct enum_traits<signed_enum> : enum_traits_signed<signed_enum, signed_enum::a, signed_enum::c>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("tombstone_traits enum")
+{
+    SECTION("unsigned")
+    {
+        verify_tombstones<small_enum>(253);
+        verify_object(small_enum::a);
+        verify_object(small_enum::b);
+        verify_object(small_enum::c);
+    }
+    SECTION("signed")
+    {
+        verify_tombstones<signed_enum>(122);
+        for (auto i = -3; i <= 5; ++i)
+            verify_object(static_cast<signed_enum>(i));
+    }
+    SECTION("int")
+    {
+        storage<int_enum> s;
+        REQUIRE(s.tombstone_count() == std::size_t(INT_MAX) - 1u);
+        for (auto i : {std::size_t(0), std::size_t(1), std::size_t(INT_MAX) - 2u})
+        {
+            s.create_tombstone(i);
+            REQUIRE(s.tombstone() == i);
+        }
+        verify_object(int_enum::a);
+        verify_object(int_enum::b);
+    }
+    SECTION("no tombstones")
+    {
+        verify_tombstones<full_enum>(0);
+        enum class unspecialized
+        {
+            a,
+        };
+        verify_tombstones<unspecialized>(0);
+    }
+}
+
+namespace
+{
+template <typename Float>
+void verify_float_tombstones(std::size_t tc)
+{
+    storage<Float> s;
+    REQUIRE(s.tombstone_count() == tc);
+    for (auto i : {std::size_t(0), std::size_t(1), std::size_t(42), tc / 2u, tc - 1u})
+    {
+        s.create_tombstone(i);
+        REQUIRE(s.tombstone() == i);
+    }
+}
+
+template <typename Float>
+void verify_float_object(Float obj)
+{
+    storage<Float> s;
+    auto&          ref = s.create_object(obj);
+    REQUIRE(std::memcmp(&ref, &obj, sizeof(Float)) == 0);
+    REQUIRE(s.tombstone() >= s.tombstone_count());
+}
+
+template <typename Float>
+void verify_float_objects()
+{
+    using limits = std::numeric_limits<Float>;
+
+    verify_float_object(Float(0));
+    verify_float_object(-Float(0));
+    verify_float_object(Float(3.14));
+    verify_float_object(-Float(42));
+    verify_float_object(limits::max());
+    verify_float_object(limits::lowest());
+    verify_float_object(limits::min());
+    verify_float_object(limits::denorm_min());
+    verify_float_object(-limits::denorm_min());
+    verify_float_object(limits::infinity());
+    verify_float_object(-limits::infinity());
+
+    verify_float_object(limits::quiet_NaN());
+    verify_float_object(-limits::quiet_NaN());
+    verify_float_object(limits::signaling_NaN());
+    verify_float_object(-limits::signaling_NaN());
+
+    // NaNs created by arithmetic
+    volatile Float zero = 0;
+    volatile Float inf  = limits::infinity();
+    verify_float_object(Float(zero / zero));
+    verify_float_object(Float(inf - inf));
+    verify_float_object(Float(zero * inf));
+    verify_float_object(Float(std::sqrt(-Float(1) + zero)));
+    verify_float_object(Float(-(zero / zero)));
+    verify_float_object(Float(limits::quiet_NaN() + Float(1)));
+}
+} // namespace
+
+TEST_CASE("tombstone_traits float")
+{
+    SECTION("float")
+    {
+        verify_float_tombstones<float>((1u << 21) - 1u);
+        verify_float_objects<float>();
+    }
+    SECTION("double")
+    {
+        verify_float_tombstones<double>(std::size_t((1ull << 50) - 1u));
+        verify_float_objects<double>();
+    }
+    SECTION("long double")
+    {
+        verify_tombstones<long double>(0);
+    }
+}
+
+TEST_CASE("tombstone_traits tiny storage")
+{
+    SECTION("tiny_storage")
+    {
+        using type = tiny_storage<tiny_unsigned<4>, tiny_bool>;
+        verify_tombstones<type>(7);
+
+        storage<type> s;
+        auto&         ref = s.create_object(type(11, true));
+        REQUIRE(ref.at<0>() == 11);
+        REQUIRE(ref.at<1>() == true);
+        REQUIRE(s.tombstone() >= s.tombstone_count());
+
+        verify_tombstones<tiny_storage<tiny_unsigned<8>>>(0);
+    }
+    SECTION("pointer_tiny_storage")
+    {
+        using type = pointer_tiny_storage<aligned_obj<int, 8>, tiny_bool>;
+        verify_tombstones<type>(3);
+
+        alignas(8) int i;
+        storage<type>  s;
+        auto&          ref = s.create_object(&i, true);
+        REQUIRE(ref.pointer() == &i);
+        REQUIRE(ref.tiny() == true);
+        REQUIRE(s.tombstone() >= s.tombstone_count());
+
+        verify_tombstones<pointer_tiny_storage<aligned_obj<int, 2>, tiny_bool>>(0);
+    }
+    SECTION("padding_tiny_storage")
+    {
+        using type = padding_tiny_storage<padded_and_layout, tiny_bool>;
+        verify_tombstones<type>(127);
+
+        storage<type> s;
+        auto&         ref = s.create_object(padded_and_layout{1, 2}, true);
+        REQUIRE(ref.object() == (padded_and_layout{1, 2}));
+        REQUIRE(ref.tiny() == true);
+        REQUIRE(s.tombstone() >= s.tombstone_count());
+    }
+}
+
 TEST_CASE("tombstone_traits optional_impl")
 {
     SECTION("not compressed")
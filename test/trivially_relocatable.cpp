@@ -0,0 +1,107 @@
+// Copyright (C) 2018 Jonathan Müller <jonathanmueller.dev@gmail.com>
+// This file is subject to the license terms in the LICENSE file
+// found in the top-level directory of this distribution.
+
+#include <foonathan/tiny/trivially_relocatable.hpp>
+
+#include <catch.hpp>
+
+#include <cstring>
+#include <string>
+
+#include <foonathan/tiny/optional_impl.hpp>
+#include <foonathan/tiny/padding_tiny_storage.hpp>
+#include <foonathan/tiny/pointer_tiny_storage.hpp>
+#include <foonathan/tiny/tiny_bool.hpp>
+#include <foonathan/tiny/tiny_int.hpp>
+
+using namespace foonathan::tiny;
+
+namespace
+{
+// not trivially copyable, but can be relocated with memcpy
+struct relocatable
+{
+    int* ptr;
+
+    relocatable() noexcept : ptr(nullptr) {}
+    relocatable(const relocatable& other) noexcept : ptr(other.ptr) {}
+    ~relocatable() noexcept {}
+
+    relocatable& operator=(const relocatable& other) noexcept
+    {
+        ptr = other.ptr;
+        return *this;
+    }
+};
+
+struct padded
+{
+    std::uint16_t a;
+    std::uint8_t  b;
+    // padding here
+};
+} // namespace
+
+namespace foonathan
+{
+namespace tiny
+{
+    template <>
+    struct is_trivially_relocatable<relocatable> : std::true_type
+    {};
+
+    template <>
+    struct padding_traits<padded> : padding_traits_aggregate<FOONATHAN_TINY_MEMBER(padded, a),
+                                                             FOONATHAN_TINY_MEMBER(padded, b)>
+    {};
+} // namespace tiny
+} // namespace foonathan
+
+TEST_CASE("is_trivially_relocatable")
+{
+    SECTION("default")
+    {
+        REQUIRE(is_trivially_relocatable<int>::value);
+        REQUIRE(is_trivially_relocatable<int*>::value);
+        REQUIRE(!is_trivially_relocatable<std::string>::value);
+        REQUIRE(is_trivially_relocatable<relocatable>::value);
+    }
+    SECTION("tiny storage")
+    {
+        REQUIRE(is_trivially_relocatable<tiny_storage<tiny_bool, tiny_unsigned<4>>>::value);
+        REQUIRE(is_trivially_relocatable<pointer_tiny_storage<int, tiny_bool>>::value);
+        REQUIRE(is_trivially_relocatable<pointer_tiny_storage<char, tiny_unsigned<4>>>::value);
+        REQUIRE(is_trivially_relocatable<padding_tiny_storage<padded, tiny_bool>>::value);
+    }
+    SECTION("optional_impl")
+    {
+        REQUIRE(is_trivially_relocatable<optional_impl<int>>::value);
+        REQUIRE(is_trivially_relocatable<optional_impl<bool>>::value);
+        REQUIRE(is_trivially_relocatable<optional_impl<int*>>::value);
+        REQUIRE(is_trivially_relocatable<optional_impl<relocatable>>::value);
+        REQUIRE(is_trivially_relocatable<optional_impl<optional_impl<relocatable>>>::value);
+        REQUIRE(!is_trivially_relocatable<optional_impl<std::string>>::value);
+    }
+    SECTION("optional_impl copy is trivial")
+    {
+        REQUIRE(std::is_trivially_copyable<optional_impl<int>>::value);
+        REQUIRE(std::is_trivially_copyable<optional_impl<bool>>::value);
+        REQUIRE(std::is_trivially_copyable<optional_impl<int*>>::value);
+        REQUIRE(std::is_trivially_copyable<optional_impl<optional_impl<bool>>>::value);
+        REQUIRE(!std::is_trivially_copyable<optional_impl<relocatable>>::value);
+    }
+    SECTION("relocate optional_impl")
+    {
+        optional_impl<relocatable> src[2];
+        int                        i = 0;
+        src[0].create_value();
+        src[0].value().ptr = &i;
+
+        optional_impl<relocatable> dest[2];
+        std::memcpy(static_cast<void*>(dest), src, sizeof(src));
+        REQUIRE(dest[0].has_value());
+        REQUIRE(dest[0].value().ptr == &i);
+        REQUIRE(!dest[1].has_value());
+    }
+}